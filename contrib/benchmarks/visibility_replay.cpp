@@ -0,0 +1,462 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Replays player relocations of a crowded city through the steps of VisibleNotifier:
+ * copy of the client guids, visit of all objects in the cells around the viewpoint,
+ * visibility check or skip of objects kept in range, out of range for the rest.
+ *
+ * The real notifier needs a loaded map with players, so the steps are repeated here on
+ * plain positions. The client guid sets are the real GuidFlatSet and the former
+ * std::set based GuidSet, which shows the gain of both parts of the incremental update:
+ *   full/set   - every visited object checked, std::set client guids (before)
+ *   full/flat  - every visited object checked, GuidFlatSet client guids
+ *   incr/flat  - objects at client staying in range skipped (Visibility.Incremental = 1)
+ *
+ * Usage: visibility_replay [options]
+ *   -t <file>   replay trace, lines of "<ms> <player> <x> <y>", players numbered from 0
+ *   -w <file>   write the generated trace to file (to replay it again with -t)
+ *   -p <count>  players of the generated trace (default 200)
+ *   -c <count>  creatures standing in the city (default 400)
+ *   -a <yards>  side of the square city area (default 300)
+ *   -s <secs>   length of the generated trace (default 60)
+ *   -d <yards>  visibility distance (default 100, Visibility.Distance.Continents)
+ *   -r <yards>  relocation distance triggering a notify (default 10, Visibility.RelocationLowerLimit)
+ *   -k <count>  extra work per visibility check, stands in for isVisibleForInState (default 64)
+ */
+
+#include "Entities/GuidFlatSet.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    float const CELL_SIZE = 533.3333f / 8;                  // SIZE_OF_GRID_CELL
+    float const RUN_SPEED = 7.0f;
+    uint32 const TICK_MS = 100;
+
+    struct TraceEntry
+    {
+        uint32 time;
+        uint32 player;
+        float x;
+        float y;
+    };
+
+    struct Options
+    {
+        Options() : players(200), creatures(400), area(300.0f), seconds(60), distance(100.0f), relocation(10.0f), checkCost(64) {}
+
+        std::string traceIn;
+        std::string traceOut;
+        uint32 players;
+        uint32 creatures;
+        float area;
+        uint32 seconds;
+        float distance;
+        float relocation;
+        uint32 checkCost;
+    };
+
+    struct ReplayObject
+    {
+        ObjectGuid guid;
+        float x;
+        float y;
+        int32 cell;
+    };
+
+    struct ReplayStats
+    {
+        ReplayStats() : notifies(0), visited(0), checks(0), kept(0), created(0), removed(0), clientGuids(0), nanos(0) {}
+
+        uint64 notifies;
+        uint64 visited;
+        uint64 checks;
+        uint64 kept;
+        uint64 created;
+        uint64 removed;
+        uint64 clientGuids;                                 // sum over all players at the end, equal for every mode
+        uint64 nanos;
+    };
+
+    volatile uint32 checkSink;
+
+    int32 ComputeCell(float x, float y)
+    {
+        return int32(std::floor(x / CELL_SIZE)) * 1024 + int32(std::floor(y / CELL_SIZE));
+    }
+
+    /// Positions of the replay with the cell lists Cell::VisitAllObjects walks
+    class ReplayWorld
+    {
+        public:
+            ReplayWorld(uint32 players, std::vector<std::pair<float, float>> const& creatures)
+            {
+                for (uint32 i = 0; i < players; ++i)
+                    Add(ObjectGuid(HIGHGUID_PLAYER, i + 1), 0.0f, 0.0f);
+                for (uint32 i = 0; i < creatures.size(); ++i)
+                    Add(ObjectGuid(HIGHGUID_UNIT, 1, i + 1), creatures[i].first, creatures[i].second);
+            }
+
+            void Relocate(uint32 index, float x, float y)
+            {
+                ReplayObject& object = m_objects[index];
+                object.x = x;
+                object.y = y;
+
+                int32 cell = ComputeCell(x, y);
+                if (cell == object.cell)
+                    return;
+
+                std::vector<uint32>& oldList = m_cells[object.cell];
+                for (uint32& entry : oldList)
+                {
+                    if (entry == index)
+                    {
+                        entry = oldList.back();
+                        oldList.pop_back();
+                        break;
+                    }
+                }
+
+                object.cell = cell;
+                m_cells[cell].push_back(index);
+            }
+
+            ReplayObject const& Get(uint32 index) const { return m_objects[index]; }
+            size_t Size() const { return m_objects.size(); }
+
+            template<typename Visitor>
+            void VisitInRange(float x, float y, float distance, Visitor&& visitor) const
+            {
+                int32 minX = int32(std::floor((x - distance) / CELL_SIZE));
+                int32 maxX = int32(std::floor((x + distance) / CELL_SIZE));
+                int32 minY = int32(std::floor((y - distance) / CELL_SIZE));
+                int32 maxY = int32(std::floor((y + distance) / CELL_SIZE));
+                for (int32 cellX = minX; cellX <= maxX; ++cellX)
+                {
+                    for (int32 cellY = minY; cellY <= maxY; ++cellY)
+                    {
+                        auto itr = m_cells.find(cellX * 1024 + cellY);
+                        if (itr == m_cells.end())
+                            continue;
+
+                        for (uint32 index : itr->second)
+                            visitor(index);
+                    }
+                }
+            }
+
+        private:
+            void Add(ObjectGuid guid, float x, float y)
+            {
+                int32 cell = ComputeCell(x, y);
+                m_cells[cell].push_back(uint32(m_objects.size()));
+                m_objects.push_back({ guid, x, y, cell });
+            }
+
+            std::vector<ReplayObject> m_objects;
+            std::unordered_map<int32, std::vector<uint32>> m_cells;
+    };
+
+    bool IsVisible(ReplayObject const& viewer, ReplayObject const& target, float distance, uint32 checkCost)
+    {
+        // stealth, phase and state checks of isVisibleForInState
+        uint32 work = uint32(target.guid.GetRawValue());
+        for (uint32 i = 0; i < checkCost; ++i)
+            work = work * 1664525 + 1013904223;
+        checkSink = work;
+
+        float dx = target.x - viewer.x;
+        float dy = target.y - viewer.y;
+        return dx * dx + dy * dy < distance * distance;
+    }
+
+    template<typename GuidSetType>
+    class Replay
+    {
+        public:
+            Replay(Options const& options, uint32 players, std::vector<std::pair<float, float>> const& creatures, bool incremental) :
+                m_options(options), m_world(players, creatures), m_clientGuids(players), m_notifyX(players), m_notifyY(players), m_incremental(incremental)
+            {}
+
+            ReplayStats Run(std::vector<TraceEntry> const& trace)
+            {
+                // everybody sees the city once before the replay, as after login
+                for (uint32 i = 0; i < m_clientGuids.size(); ++i)
+                    Notify(i, false);
+                m_stats = ReplayStats();
+
+                auto startTime = std::chrono::steady_clock::now();
+                for (TraceEntry const& entry : trace)
+                {
+                    m_world.Relocate(entry.player, entry.x, entry.y);
+
+                    float dx = entry.x - m_notifyX[entry.player];
+                    float dy = entry.y - m_notifyY[entry.player];
+                    if (dx * dx + dy * dy < m_options.relocation * m_options.relocation)
+                        continue;
+
+                    Notify(entry.player, m_incremental);
+                }
+                m_stats.nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+
+                for (GuidSetType const& guids : m_clientGuids)
+                    m_stats.clientGuids += guids.size();
+                return m_stats;
+            }
+
+        private:
+            // VisibleNotifier constructor, Visit and Notify of a moved viewpoint
+            void Notify(uint32 player, bool relocated)
+            {
+                ReplayObject const& viewer = m_world.Get(player);
+                m_notifyX[player] = viewer.x;
+                m_notifyY[player] = viewer.y;
+                ++m_stats.notifies;
+
+                GuidSetType& clientGuids = m_clientGuids[player];
+                GuidSetType notVisited(clientGuids);
+                float keptRangeSq = relocated ? m_options.distance * m_options.distance : 0.0f;
+
+                m_world.VisitInRange(viewer.x, viewer.y, m_options.distance, [&](uint32 index)
+                {
+                    if (index == player)
+                        return;
+
+                    ++m_stats.visited;
+                    ReplayObject const& target = m_world.Get(index);
+                    bool atClient = notVisited.erase(target.guid) != 0;
+                    if (atClient && keptRangeSq)
+                    {
+                        float dx = target.x - viewer.x;
+                        float dy = target.y - viewer.y;
+                        if (dx * dx + dy * dy < keptRangeSq)
+                        {
+                            ++m_stats.kept;
+                            return;
+                        }
+                    }
+
+                    ++m_stats.checks;
+                    if (IsVisible(viewer, target, m_options.distance, m_options.checkCost))
+                    {
+                        if (!atClient && clientGuids.insert(target.guid).second)
+                            ++m_stats.created;
+                    }
+                    else if (atClient)
+                    {
+                        clientGuids.erase(target.guid);
+                        ++m_stats.removed;
+                    }
+                });
+
+                // not visited objects are out of range
+                for (ObjectGuid const& guid : notVisited)
+                {
+                    clientGuids.erase(guid);
+                    ++m_stats.removed;
+                }
+            }
+
+            Options const& m_options;
+            ReplayWorld m_world;
+            std::vector<GuidSetType> m_clientGuids;
+            std::vector<float> m_notifyX;
+            std::vector<float> m_notifyY;
+            bool m_incremental;
+            ReplayStats m_stats;
+    };
+
+    /// GuidFlatSet::insert returns bool, std::set::insert a pair
+    class FlatClientGuids : public GuidFlatSet
+    {
+        public:
+            struct InsertResult { bool second; };
+
+            InsertResult insert(ObjectGuid guid) { return { GuidFlatSet::insert(guid) }; }
+    };
+
+    // crowded city: players walk between random points of the area at run speed
+    std::vector<TraceEntry> GenerateTrace(Options const& options)
+    {
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> position(0.0f, options.area);
+
+        struct Walker { float x, y, destX, destY; };
+        std::vector<Walker> walkers(options.players);
+        for (Walker& walker : walkers)
+            walker = { position(random), position(random), position(random), position(random) };
+
+        std::vector<TraceEntry> trace;
+        for (uint32 i = 0; i < options.players; ++i)
+            trace.push_back({ 0, i, walkers[i].x, walkers[i].y });
+
+        float step = RUN_SPEED * TICK_MS / 1000.0f;
+        for (uint32 time = TICK_MS; time <= options.seconds * 1000; time += TICK_MS)
+        {
+            for (uint32 i = 0; i < options.players; ++i)
+            {
+                Walker& walker = walkers[i];
+                float dx = walker.destX - walker.x;
+                float dy = walker.destY - walker.y;
+                float dist = std::sqrt(dx * dx + dy * dy);
+                if (dist <= step)
+                {
+                    walker.x = walker.destX;
+                    walker.y = walker.destY;
+                    walker.destX = position(random);
+                    walker.destY = position(random);
+                }
+                else
+                {
+                    walker.x += dx / dist * step;
+                    walker.y += dy / dist * step;
+                }
+                trace.push_back({ time, i, walker.x, walker.y });
+            }
+        }
+        return trace;
+    }
+
+    bool LoadTrace(std::string const& fileName, std::vector<TraceEntry>& trace, uint32& players)
+    {
+        FILE* file = fopen(fileName.c_str(), "r");
+        if (!file)
+            return false;
+
+        players = 0;
+        TraceEntry entry;
+        while (fscanf(file, "%u %u %f %f", &entry.time, &entry.player, &entry.x, &entry.y) == 4)
+        {
+            trace.push_back(entry);
+            players = std::max(players, entry.player + 1);
+        }
+        fclose(file);
+        return true;
+    }
+
+    bool SaveTrace(std::string const& fileName, std::vector<TraceEntry> const& trace)
+    {
+        FILE* file = fopen(fileName.c_str(), "w");
+        if (!file)
+            return false;
+
+        for (TraceEntry const& entry : trace)
+            fprintf(file, "%u %u %.2f %.2f\n", entry.time, entry.player, entry.x, entry.y);
+        fclose(file);
+        return true;
+    }
+
+    void PrintStats(char const* name, ReplayStats const& stats)
+    {
+        double notifies = stats.notifies ? double(stats.notifies) : 1.0;
+        printf("%-10s %9llu %10.1f %10.1f %10.1f %12.0f %12llu\n", name, (unsigned long long)stats.notifies,
+            stats.visited / notifies, stats.checks / notifies, stats.kept / notifies, stats.nanos / notifies, (unsigned long long)stats.clientGuids);
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            if (argv[i][0] != '-' || strlen(argv[i]) != 2 || i + 1 >= argc)
+                return false;
+
+            char const* value = argv[++i];
+            switch (argv[i - 1][1])
+            {
+                case 't': options.traceIn = value; break;
+                case 'w': options.traceOut = value; break;
+                case 'p': options.players = uint32(atoi(value)); break;
+                case 'c': options.creatures = uint32(atoi(value)); break;
+                case 'a': options.area = float(atof(value)); break;
+                case 's': options.seconds = uint32(atoi(value)); break;
+                case 'd': options.distance = float(atof(value)); break;
+                case 'r': options.relocation = float(atof(value)); break;
+                case 'k': options.checkCost = uint32(atoi(value)); break;
+                default: return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        printf("Usage: %s [-t trace] [-w trace] [-p players] [-c creatures] [-a area] [-s seconds] [-d distance] [-r relocation] [-k checkcost]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<TraceEntry> trace;
+    uint32 players = options.players;
+    if (!options.traceIn.empty())
+    {
+        if (!LoadTrace(options.traceIn, trace, players))
+        {
+            printf("Can not read trace %s\n", options.traceIn.c_str());
+            return 1;
+        }
+    }
+    else
+        trace = GenerateTrace(options);
+
+    if (!options.traceOut.empty() && !SaveTrace(options.traceOut, trace))
+    {
+        printf("Can not write trace %s\n", options.traceOut.c_str());
+        return 1;
+    }
+
+    // creatures stand still, spread over the area covered by the trace
+    float minX = trace.empty() ? 0.0f : trace.front().x, maxX = minX;
+    float minY = trace.empty() ? 0.0f : trace.front().y, maxY = minY;
+    for (TraceEntry const& entry : trace)
+    {
+        minX = std::min(minX, entry.x);
+        maxX = std::max(maxX, entry.x);
+        minY = std::min(minY, entry.y);
+        maxY = std::max(maxY, entry.y);
+    }
+
+    std::mt19937 random(2);
+    std::uniform_real_distribution<float> creatureX(minX, maxX);
+    std::uniform_real_distribution<float> creatureY(minY, maxY);
+    std::vector<std::pair<float, float>> creatures(options.creatures);
+    for (auto& creature : creatures)
+        creature = { creatureX(random), creatureY(random) };
+
+    printf("%u players, %u creatures, %u relocations, visibility distance %.0f, relocation limit %.0f, check cost %u\n\n",
+        players, options.creatures, uint32(trace.size()), options.distance, options.relocation, options.checkCost);
+    printf("%-10s %9s %10s %10s %10s %12s %12s\n", "mode", "notifies", "visited/n", "checks/n", "kept/n", "ns/notify", "client guids");
+
+    PrintStats("full/set", Replay<std::set<ObjectGuid>>(options, players, creatures, false).Run(trace));
+    PrintStats("full/flat", Replay<FlatClientGuids>(options, players, creatures, false).Run(trace));
+    PrintStats("incr/flat", Replay<FlatClientGuids>(options, players, creatures, true).Run(trace));
+    return 0;
+}
@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_s2485_01_mangos_closing_text required_s2486_01_mangos_server_mapupdates bit;
+
+DELETE FROM command WHERE name IN ('server mapupdates');
+
+INSERT INTO command VALUES
+('server mapupdates',3,'Syntax: .server mapupdates [#count]\r\n\r\nShow the #count (default 10) loaded maps with the most expensive updates: rolling average, last and max update time, updated objects and players.');
@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_s2486_01_mangos_server_mapupdates required_s2487_01_mangos_reload_storage_cache bit;
+
+DELETE FROM command WHERE name IN ('reload storage_cache');
+
+INSERT INTO command VALUES
+('reload storage_cache',3,'Syntax: .reload storage_cache\r\n\r\nRemove the world table snapshots in WorldDatabaseCacheDir, so the tables are loaded from the database and the snapshots rebuilt at next startup.');
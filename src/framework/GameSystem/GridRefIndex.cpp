@@ -0,0 +1,69 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "GameSystem/GridRefIndex.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GRIDREFINDEX_SSE2
+#endif
+
+uint64 GridRefIndexMatch(float const* x, float const* y, float const* reach, uint32 count, float centerX, float centerY, float range)
+{
+    uint64 mask = 0;
+    uint32 i = 0;
+
+#if defined(__AVX2__)
+    __m256 const cx = _mm256_set1_ps(centerX);
+    __m256 const cy = _mm256_set1_ps(centerY);
+    __m256 const r = _mm256_set1_ps(range);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&x[i]), cx);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&y[i]), cy);
+        __m256 maxDist = _mm256_add_ps(r, _mm256_loadu_ps(&reach[i]));
+        __m256 inRange = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(maxDist, maxDist), _CMP_LE_OQ);
+        mask |= uint64(_mm256_movemask_ps(inRange)) << i;
+    }
+#elif defined(GRIDREFINDEX_SSE2)
+    __m128 const cx = _mm_set1_ps(centerX);
+    __m128 const cy = _mm_set1_ps(centerY);
+    __m128 const r = _mm_set1_ps(range);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&x[i]), cx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&y[i]), cy);
+        __m128 maxDist = _mm_add_ps(r, _mm_loadu_ps(&reach[i]));
+        __m128 inRange = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(maxDist, maxDist));
+        mask |= uint64(_mm_movemask_ps(inRange)) << i;
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        float dx = x[i] - centerX;
+        float dy = y[i] - centerY;
+        float maxDist = range + reach[i];
+        if (dx * dx + dy * dy <= maxDist * maxDist)
+            mask |= uint64(1) << i;
+    }
+
+    return mask;
+}
@@ -0,0 +1,114 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _GRIDREFINDEX_H
+#define _GRIDREFINDEX_H
+
+#include "Platform/Define.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+template<class OBJECT> class GridReference;
+
+/** Returns a mask with bit i set for every entry i of the count (at most 64) entries whose 2D distance
+    from (centerX, centerY) is at most range + reach[i]
+ */
+uint64 GridRefIndexMatch(float const* x, float const* y, float const* reach, uint32 count, float centerX, float centerY, float range);
+
+/** Packed positions of the objects linked to one grid list, in link order.
+
+    Grid searchers test the objects of a cell against their search circle here, so
+    objects far away are skipped without being touched. The reach of an object is
+    the distance its own size adds to range checks. An entry without a known position
+    has infinite reach and is never skipped.
+ */
+template<class OBJECT>
+class GridRefIndex
+{
+    public:
+
+        uint32 Add(GridReference<OBJECT>* ref)
+        {
+            i_x.push_back(0.0f);
+            i_y.push_back(0.0f);
+            i_reach.push_back(std::numeric_limits<float>::infinity());
+            i_refs.push_back(ref);
+            return i_refs.size() - 1;
+        }
+
+        void Remove(uint32 slot)
+        {
+            // erased in place, the order of entries follows the order of the list
+            i_x.erase(i_x.begin() + slot);
+            i_y.erase(i_y.begin() + slot);
+            i_reach.erase(i_reach.begin() + slot);
+            i_refs.erase(i_refs.begin() + slot);
+
+            for (uint32 i = slot; i < i_refs.size(); ++i)
+                i_refs[i]->setIndexSlot(i);
+        }
+
+        void SetPosition(uint32 slot, float x, float y, float reach)
+        {
+            i_x[slot] = x;
+            i_y[slot] = y;
+            i_reach[slot] = reach;
+        }
+
+        /** Calls visit for the objects that can be within range of (x, y), newest linked
+            first like the list iteration, and stops as soon as visit returns false.
+         */
+        template<class VISIT>
+        bool VisitInRange(float x, float y, float range, VISIT&& visit) const
+        {
+            OBJECT* candidates[CHUNK_SIZE];
+            for (uint32 end = i_refs.size(); end > 0;)
+            {
+                // visit may move objects out of this list
+                end = std::min<uint32>(end, i_refs.size());
+                uint32 begin = end > CHUNK_SIZE ? end - CHUNK_SIZE : 0;
+
+                uint64 mask = GridRefIndexMatch(&i_x[begin], &i_y[begin], &i_reach[begin], end - begin, x, y, range);
+                uint32 count = 0;
+                for (uint32 i = end; i > begin; --i)
+                    if (mask & (uint64(1) << (i - 1 - begin)))
+                        candidates[count++] = i_refs[i - 1]->getSource();
+
+                for (uint32 i = 0; i < count; ++i)
+                    if (!visit(candidates[i]))
+                        return false;
+
+                end = begin;
+            }
+
+            return true;
+        }
+
+    private:
+
+        static uint32 const CHUNK_SIZE = 64;
+
+        std::vector<float> i_x;
+        std::vector<float> i_y;
+        std::vector<float> i_reach;
+        std::vector<GridReference<OBJECT>*> i_refs;
+};
+
+#endif
@@ -20,6 +20,7 @@
 #define _GRIDREFMANAGER
 
 #include "Utilities/LinkedReference/RefManager.h"
+#include "GameSystem/GridRefIndex.h"
 
 template<class OBJECT> class GridReference;
 
@@ -30,6 +31,9 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
 
         typedef LinkedListHead::Iterator< GridReference<OBJECT> > iterator;
 
+        // references are released while the index still exists
+        ~GridRefManager() { this->clearReferences(); }
+
         GridReference<OBJECT>* getFirst()
         {
             return (GridReference<OBJECT>*)RefManager<GridRefManager<OBJECT>, OBJECT>::getFirst();
@@ -44,5 +48,12 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
         iterator end() { return iterator(nullptr); }
         iterator rbegin() { return iterator(getLast()); }
         iterator rend() { return iterator(nullptr); }
+
+        GridRefIndex<OBJECT>& GetIndex() { return i_index; }
+        GridRefIndex<OBJECT> const& GetIndex() const { return i_index; }
+
+    private:
+
+        GridRefIndex<OBJECT> i_index;
 };
 #endif
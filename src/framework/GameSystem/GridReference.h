@@ -33,25 +33,30 @@ class GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
             // called from link()
             this->getTarget()->insertFirst(this);
             this->getTarget()->incSize();
+            i_indexSlot = this->getTarget()->GetIndex().Add(this);
         }
 
         void targetObjectDestroyLink() override
         {
             // called from unlink()
             if (this->isValid())
+            {
                 this->getTarget()->decSize();
+                this->getTarget()->GetIndex().Remove(i_indexSlot);
+            }
         }
 
         void sourceObjectDestroyLink() override
         {
             // called from invalidate()
             this->getTarget()->decSize();
+            this->getTarget()->GetIndex().Remove(i_indexSlot);
         }
 
     public:
 
         GridReference()
-            : Reference<GridRefManager<OBJECT>, OBJECT>()
+            : Reference<GridRefManager<OBJECT>, OBJECT>(), i_indexSlot(0)
         {
         }
 
@@ -64,6 +69,19 @@ class GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
         {
             return (GridReference*)Reference<GridRefManager<OBJECT>, OBJECT>::next();
         }
+
+        // position of the object in the packed index of the linked list, see GridRefIndex
+        void updateIndex(float x, float y, float reach)
+        {
+            if (this->isValid())
+                this->getTarget()->GetIndex().SetPosition(i_indexSlot, x, y, reach);
+        }
+
+        void setIndexSlot(uint32 slot) { i_indexSlot = slot; }
+
+    private:
+
+        uint32 i_indexSlot;
 };
 
 #endif
@@ -363,7 +363,7 @@ struct spell_seed_of_corruption_npc : public AuraScript
         }
 
         // Damage counting
-        mod->m_amount -= procData.damage;
+        procData.triggeredByAura->SetAmount(mod->m_amount - procData.damage);
         return SPELL_AURA_PROC_OK;
     }
 };
@@ -25,6 +25,7 @@
 #include <cstdarg>
 #include <cstdio>
 #include <sstream>
+#include <algorithm>
 
 namespace
 {
@@ -45,6 +46,60 @@ uint32 GetAccountLevel(uint32 accountId)
 
     return 0;
 }
+
+size_t const FINGERPRINT_GRAM = 3;
+
+// sorted trigrams of the message, each packed losslessly into one value
+std::vector<uint32> GetFingerprint(const std::string &msg)
+{
+    std::vector<uint32> grams;
+
+    if (msg.length() < FINGERPRINT_GRAM)
+        return grams;
+
+    grams.reserve(msg.length() - FINGERPRINT_GRAM + 1);
+    for (size_t i = 0; i + FINGERPRINT_GRAM <= msg.length(); ++i)
+        grams.push_back(uint32(uint8(msg[i])) << 16 | uint32(uint8(msg[i + 1])) << 8 | uint32(uint8(msg[i + 2])));
+
+    std::sort(grams.begin(), grams.end());
+    return grams;
+}
+
+// number of trigrams the messages have in common, counting repeated trigrams
+size_t SharedGrams(const std::vector<uint32> &a, const std::vector<uint32> &b)
+{
+    size_t shared = 0;
+    for (auto i = a.begin(), j = b.begin(); i != a.end() && j != b.end();)
+    {
+        if (*i < *j)
+            ++i;
+        else if (*j < *i)
+            ++j;
+        else
+        {
+            ++shared;
+            ++i;
+            ++j;
+        }
+    }
+    return shared;
+}
+
+// false when the distance of the messages is certainly above maxDistance.  every edit operation, a
+// transposition included, changes the length by at most one and destroys at most FINGERPRINT_GRAM + 1
+// trigrams, so messages within maxDistance share enough trigrams of the longer one
+bool CanBeWithinDistance(const std::string &a, const std::vector<uint32> &aGrams, const std::string &b, const std::vector<uint32> &bGrams, size_t maxDistance)
+{
+    auto const longer = std::max(a.length(), b.length());
+    if (longer - std::min(a.length(), b.length()) > maxDistance)
+        return false;
+
+    auto const destroyed = maxDistance * (FINGERPRINT_GRAM + 1);
+    if (longer < FINGERPRINT_GRAM || longer - FINGERPRINT_GRAM + 1 <= destroyed)
+        return true;
+
+    return SharedGrams(aGrams, bGrams) >= longer - FINGERPRINT_GRAM + 1 - destroyed;
+}
 }
 
 namespace NamreebAnticheat
@@ -515,18 +570,25 @@ void Antispam::Analyze()
     }
 
     // step 5: see if they are repeating their messages too often
+    auto const threshold = sAnticheatConfig.GetAntispamUniquenessThreshold();
     for (auto const &msg : messages)
     {
+        auto fingerprint = GetFingerprint(msg);
+
         // first see if the message is similar to previously observed unique messages
         bool found = false;
-        for (auto i = 0u; i < _uniqueMessages.size(); ++i)
+        for (auto i = 0u; i < _uniqueMessages.size() && threshold > 0; ++i)
         {
             auto &u = _uniqueMessages[i];
 
+            // most messages differ too much to need the exact distance
+            if (!CanBeWithinDistance(msg, fingerprint, u.second, _uniqueFingerprints[i], threshold - 1))
+                continue;
+
             auto const distance = static_cast<uint32>(nam::damerau_levenshtein_distance(msg, u.second));
 
             // if these two messages are the same, increase the count
-            if (distance < sAnticheatConfig.GetAntispamUniquenessThreshold())
+            if (distance < threshold)
             {
                 ++u.first;
                 found = true;
@@ -539,6 +601,7 @@ void Antispam::Analyze()
 
         // otherwise, insert the message to track it for repetition
         _uniqueMessages.emplace_back(1, msg);
+        _uniqueFingerprints.push_back(std::move(fingerprint));
     }
 
     auto const score = RepetitionScore();
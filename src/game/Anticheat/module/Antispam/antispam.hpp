@@ -62,6 +62,9 @@ class Antispam : public std::enable_shared_from_this<Antispam>
         // unique messages as determined by fuzzy string comparison
         std::vector<std::pair<uint32, std::string> > _uniqueMessages;
 
+        // sorted trigrams of each entry of _uniqueMessages, to skip edit distances which cannot be under the threshold
+        std::vector<std::vector<uint32> > _uniqueFingerprints;
+
         // log of highest scoring blacklist messages, along with which blacklist entries contributed to the score.
         // this container is updated by analysis thread, so results are not available in real time.
         nam::priority<std::string, uint32, 5> _topBlacklistedMessages;
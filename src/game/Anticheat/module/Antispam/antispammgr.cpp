@@ -18,8 +18,8 @@
 
 #include <string>
 #include <mutex>
+#include <shared_mutex>
 #include <vector>
-#include <regex>
 #include <algorithm>
 #include <memory>
 #include <unordered_set>
@@ -41,22 +41,93 @@ void ReplaceAll(std::string &str, const std::string& from, const std::string& to
     }
 }
 
-void ReplaceAllW(std::wstring &str, const std::wstring& from, const std::wstring& to)
+// character classes of the normalization filters, equal to the classic locale classes used before
+enum CharClass : uint8
 {
-    size_t startPos = 0;
-    while ((startPos = str.find(from, startPos)) != std::wstring::npos)
+    CHAR_CLASS_CNTRL    = 0x01,
+    CHAR_CLASS_PUNCT    = 0x02,
+    CHAR_CLASS_SPACE    = 0x04,                 // whitespace and '_'
+    CHAR_CLASS_DIGIT    = 0x08,
+    CHAR_CLASS_WORD     = 0x10,                 // [A-Za-z0-9_]
+};
+
+struct CharClassTable
+{
+    std::array<uint8, 256> classes;
+    std::array<char, 256> upper;
+
+    CharClassTable()
     {
-        str.replace(startPos, from.length(), to);
-        startPos += to.length();
+        for (auto c = 0u; c < 256; ++c)
+        {
+            uint8 mask = 0;
+
+            if (c < 0x20 || c == 0x7F)
+                mask |= CHAR_CLASS_CNTRL;
+            if ((c >= '!' && c <= '/') || (c >= ':' && c <= '@') || (c >= '[' && c <= '`') || (c >= '{' && c <= '~'))
+                mask |= CHAR_CLASS_PUNCT;
+            if ((c >= '\t' && c <= '\r') || c == ' ' || c == '_')
+                mask |= CHAR_CLASS_SPACE;
+            if (c >= '0' && c <= '9')
+                mask |= CHAR_CLASS_DIGIT;
+            if ((c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_')
+                mask |= CHAR_CLASS_WORD;
+
+            classes[c] = mask;
+            upper[c] = static_cast<char>(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+        }
+    }
+
+    bool Is(char c, uint8 mask) const { return !!(classes[static_cast<uint8>(c)] & mask); }
+    char ToUpper(char c) const { return upper[static_cast<uint8>(c)]; }
+};
+
+const CharClassTable charClasses;
+
+// removes |cAARRGGBB color codes, |h|r link ends and everything from the first |H to the last |h
+void CutColor(std::string &msg)
+{
+    size_t out = 0;
+    for (size_t i = 0; i < msg.size();)
+    {
+        if (msg[i] == '|' && i + 10 <= msg.size() && msg[i + 1] == 'c')
+        {
+            auto wordChars = 0u;
+            while (wordChars < 8 && charClasses.Is(msg[i + 2 + wordChars], CHAR_CLASS_WORD))
+                ++wordChars;
+
+            if (wordChars == 8)
+            {
+                i += 10;
+                continue;
+            }
+        }
+
+        msg[out++] = msg[i++];
     }
+    msg.resize(out);
+
+    ReplaceAll(msg, "|h|r", "");
+
+    auto const linkStart = msg.find("|H");
+    if (linkStart == std::string::npos)
+        return;
+
+    auto const linkEnd = msg.rfind("|h");
+    if (linkEnd != std::string::npos && linkEnd >= linkStart + 3)
+        msg.erase(linkStart, linkEnd + 2 - linkStart);
 }
+
+// per thread buffers of the unicode pass, they keep their capacity between messages
+thread_local std::wstring unicodeBuffer;
+thread_local std::wstring unicodeBuffer2;
 }
 
 namespace NamreebAnticheat
 {
 std::string AntispamMgr::NormalizeString(const std::string &string, uint32 mask) const
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::shared_lock<std::shared_mutex> guard(_dataMutex);
     return NormalizeStringInternal(string, mask);
 }
 
@@ -65,13 +136,7 @@ std::string AntispamMgr::NormalizeStringInternal(const std::string &string, uint
     auto newMsg = string;
 
     if (mask & NF_CUT_COLOR)
-    {
-        static const std::regex regex1("(\\|c\\w{8})");
-        static const std::regex regex2("(\\|H[\\w|\\W]{1,}\\|h)");
-        newMsg = std::regex_replace(newMsg, regex1, "");
-        ReplaceAll(newMsg, "|h|r", "");
-        newMsg = std::regex_replace(newMsg, regex2, "");
-    }
+        CutColor(newMsg);
 
     if (mask & NF_REPLACE_WORDS)
     {
@@ -79,46 +144,63 @@ std::string AntispamMgr::NormalizeStringInternal(const std::string &string, uint
             ReplaceAll(newMsg, e.first, e.second);
     }
 
+    uint8 cutClasses = 0;
     if (mask & NF_CUT_CTRL)
-    {
-        static const std::regex regex4("([[:cntrl:]]+)");
-        newMsg = std::regex_replace(newMsg, regex4, "");
-    }
-
+        cutClasses |= CHAR_CLASS_CNTRL;
     if (mask & NF_CUT_PUNCT)
-    {
-        static const std::regex regex5("([[:punct:]]+)");
-        newMsg = std::regex_replace(newMsg, regex5, "");
-    }
-
+        cutClasses |= CHAR_CLASS_PUNCT;
     if (mask & NF_CUT_SPACE)
-    {
-        static const std::regex regex6("(\\s+|_)");
-        newMsg = std::regex_replace(newMsg, regex6, "");
-    }
-
+        cutClasses |= CHAR_CLASS_SPACE;
     if (mask & NF_CUT_NUMBERS)
+        cutClasses |= CHAR_CLASS_DIGIT;
+
+    bool const upperCase = !(mask & NF_REPLACE_UNICODE);
+    bool const removeRepeats = upperCase && (mask & NF_REMOVE_REPEATS);
+
+    // single pass over the message for the character filters, and without unicode handling for case and repeats too
+    size_t out = 0;
+    for (auto c : newMsg)
     {
-        static std::regex regex3("(\\d+)");
-        newMsg = std::regex_replace(newMsg, regex3, "");
+        if (charClasses.Is(c, cutClasses))
+            continue;
+
+        if (upperCase)
+            c = charClasses.ToUpper(c);
+
+        if (removeRepeats && out > 0 && newMsg[out - 1] == c)
+            continue;
+
+        newMsg[out++] = c;
     }
+    newMsg.resize(out);
 
-    if (mask & NF_REPLACE_UNICODE)
+    if (!upperCase)
     {
-        std::wstring w_tempMsg, w_tempMsg2;
+        std::wstring &w_tempMsg = unicodeBuffer;
+        std::wstring &w_tempMsg2 = unicodeBuffer2;
+        w_tempMsg.clear();
+        w_tempMsg2.clear();
+
         Utf8toWStr(newMsg, w_tempMsg);
         wstrToUpper(w_tempMsg);
 
         if (!isBasicLatinString(w_tempMsg, true))
         {
-            for (auto const& s : _unicodeReplace)
-                ReplaceAllW(w_tempMsg, s.first, s.second);
+            if (!_unicodeReplace.empty())
+            {
+                for (auto &c : w_tempMsg)
+                {
+                    auto const i = _unicodeReplace.find(c);
+                    if (i != _unicodeReplace.end())
+                        c = i->second;
+                }
+            }
 
             if (mask & NF_REMOVE_NON_LATIN)
             {
-                for (size_t i = 0; i < w_tempMsg.size(); ++i)
-                    if (isBasicLatinCharacter(w_tempMsg[i]) || isNumeric(w_tempMsg[i]))
-                        w_tempMsg2.push_back(w_tempMsg[i]);
+                for (auto const c : w_tempMsg)
+                    if (isBasicLatinCharacter(c) || isNumeric(c))
+                        w_tempMsg2.push_back(c);
             }
             else
                 w_tempMsg2 = w_tempMsg;
@@ -126,13 +208,11 @@ std::string AntispamMgr::NormalizeStringInternal(const std::string &string, uint
         else
             w_tempMsg2 = w_tempMsg;
 
-        newMsg = std::string(w_tempMsg2.begin(), w_tempMsg2.end());
-    }
-    else
-        std::transform(newMsg.begin(), newMsg.end(), newMsg.begin(), ::toupper);
+        newMsg.assign(w_tempMsg2.begin(), w_tempMsg2.end());
 
-    if (mask & NF_REMOVE_REPEATS)
-        newMsg.erase(std::unique(newMsg.begin(), newMsg.end()), newMsg.end());
+        if (mask & NF_REMOVE_REPEATS)
+            newMsg.erase(std::unique(newMsg.begin(), newMsg.end()), newMsg.end());
+    }
 
     return newMsg;
 }
@@ -198,7 +278,7 @@ void AntispamMgr::WorkerLoop()
 
 void AntispamMgr::LoadFromDB()
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::unique_lock<std::shared_mutex> guard(_dataMutex);
 
     auto const normMask = sAnticheatConfig.GetSpamNormalizationMask();
 
@@ -251,30 +331,36 @@ void AntispamMgr::LoadFromDB()
 
     _unicodeReplace.clear();
 
+    std::vector<std::pair<wchar_t, wchar_t> > unicodeReplace;
+
     if (queryResult)
         do
         {
-            std::wostringstream wss;
-
             auto fields = queryResult->Fetch();
-            
-            wss.str(std::wstring());
-            wss << wchar_t(fields[0].GetUInt32());
-            std::wstring key = wss.str();
+            unicodeReplace.emplace_back(wchar_t(fields[0].GetUInt32()), wchar_t(fields[1].GetUInt32()));
+        } while (queryResult->NextRow());
 
-            wss.str(std::wstring());
-            wss << wchar_t(fields[1].GetUInt32());
-            std::wstring value = wss.str();
+    // replacements used to be applied one after another over the whole message, so a character
+    // replaced by one entry could be replaced again by a later one.  resolve these chains once here
+    for (auto const &r : unicodeReplace)
+    {
+        if (_unicodeReplace.find(r.first) != _unicodeReplace.end())
+            continue;
 
-            _unicodeReplace.emplace_back(key, value);
-        } while (queryResult->NextRow());
+        auto c = r.first;
+        for (auto const &next : unicodeReplace)
+            if (next.first == c)
+                c = next.second;
+
+        _unicodeReplace[r.first] = c;
+    }
 
     sLog.outString(">> %lu unicode character replacements loaded", uint64(_unicodeReplace.size()));
 }
 
 void AntispamMgr::BlacklistAdd(const std::string &string_)
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::unique_lock<std::shared_mutex> guard(_dataMutex);
 
     // cannot be empty!
     if (string_.empty())
@@ -307,7 +393,7 @@ void AntispamMgr::BlacklistAdd(const std::string &string_)
 
 uint32 AntispamMgr::CheckBlacklist(const std::string &string, std::string &log) const
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::shared_lock<std::shared_mutex> guard(_dataMutex);
 
     auto const normalizationMask = sAnticheatConfig.GetSpamNormalizationMask();
     auto const msg = NormalizeStringInternal(string, normalizationMask);
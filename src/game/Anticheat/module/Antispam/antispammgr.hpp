@@ -14,6 +14,7 @@
 #include <string>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_set>
 #include <unordered_map>
 #include <thread>
@@ -29,20 +30,20 @@ class Antispam;
 class AntispamMgr
 {
     private:
-        // note that once we begin using c++17, std::shared_mutex will be much more performant
-        // here as the guarded values are seldom changed but frequently read
+        // guards the work queue and the session cache
         mutable std::mutex _mutex;
 
+        // guards the blacklist and the replacements, which are seldom changed but read for every chat message.
+        // readers take it shared, so normalization on different threads does not wait for each other
+        mutable std::shared_mutex _dataMutex;
+
         std::atomic<bool> _shutdownRequested;
 
         // this collection contains a pair of strings, the original entry and the normalized version based on current settings
         std::vector<std::pair<std::string, std::string> > _blacklist;
 
-        // NOTE: _asciiReplace and _unicodeReplace are not protected by _mutex, because it would make the code much more complicated
-        // and they should never be changing once the world server has started.
-
         std::vector<std::pair<std::string, std::string> > _asciiReplace;        // replacements for ascii strings (for things like @ -> A or \/\/ -> W etc.)
-        std::vector<std::pair<std::wstring, std::wstring> > _unicodeReplace;    // replacements for individual unicode characters
+        std::unordered_map<wchar_t, wchar_t> _unicodeReplace;                  // replacements for individual unicode characters, chains already resolved
 
         // set of sessions to analyze in the next tick of the antispam worker thread
         std::unordered_set<std::shared_ptr<Antispam> > _workQueue;
@@ -53,7 +54,7 @@ class AntispamMgr
         // the thread is declared after all other members to guarantee that it is initialized last
         std::thread _worker;
 
-        // this function performs the actual normalization, but assumes that the mutex is already locked
+        // this function performs the actual normalization, but assumes that _dataMutex is already locked
         std::string NormalizeStringInternal(const std::string &string, uint32 mask) const;
 
         void WorkerLoop();
@@ -64,7 +65,7 @@ class AntispamMgr
 
         void LoadFromDB();
 
-        // assumes ownership of the mutex and normalizes a string
+        // locks _dataMutex shared and normalizes a string
         std::string NormalizeString(const std::string &string, uint32 mask) const;
 
         void BlacklistAdd(const std::string &string);
@@ -48,6 +48,23 @@ AuctionHouseMgr::~AuctionHouseMgr()
         delete itr->second;
 }
 
+AuctionItemNames const& AuctionHouseMgr::GetItemNames(ItemPrototype const* proto, int32 locIdx)
+{
+    uint64 key = uint64(uint32(locIdx + 1)) << 32 | proto->ItemId;
+    ItemNamesMap::iterator itr = mItemNames.find(key);
+    if (itr != mItemNames.end())
+        return itr->second;
+
+    std::string name = proto->Name1;
+    sObjectMgr.GetItemLocaleStrings(proto->ItemId, locIdx, &name);
+
+    AuctionItemNames& names = mItemNames[key];
+    Utf8toWStr(name, names.name);
+    names.lowerName = names.name;
+    wstrToLower(names.lowerName);
+    return names;
+}
+
 AuctionHouseObject* AuctionHouseMgr::GetAuctionsMap(AuctionHouseEntry const* house)
 {
     if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_AUCTION))
@@ -589,12 +606,68 @@ void AuctionHouseObject::Update()
 
             itr->second->DeleteFromDB();
             sAuctionMgr.RemoveAItem(itr->second->itemGuidLow);
+            AuctionsByClass[GetClassKey(itr->second)].erase(itr->first);
             delete itr->second;
             AuctionsMap.erase(itr++);
         }
     }
 }
 
+uint32 AuctionHouseObject::GetClassKey(AuctionEntry const* auction)
+{
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+    return proto ? (proto->Class << 16 | proto->SubClass) : 0xffffffff;
+}
+
+void AuctionHouseObject::AddAuction(AuctionEntry* ah)
+{
+    MANGOS_ASSERT(ah);
+    AuctionsMap[ah->Id] = ah;
+    AuctionsByClass[GetClassKey(ah)][ah->Id] = ah;
+}
+
+bool AuctionHouseObject::RemoveAuction(uint32 id)
+{
+    AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+    if (itr == AuctionsMap.end())
+        return false;
+
+    AuctionsByClass[GetClassKey(itr->second)].erase(id);
+    AuctionsMap.erase(itr);
+    return true;
+}
+
+void AuctionHouseObject::GetAuctionsByClass(uint32 itemClass, uint32 itemSubClass, std::vector<AuctionEntry*>& auctions) const
+{
+    if (itemClass == 0xffffffff)
+    {
+        auctions.reserve(AuctionsMap.size());
+        for (const auto& auc : AuctionsMap)
+            auctions.push_back(auc.second);
+        return;
+    }
+
+    // class and subclass are client provided, the key holds 16 bits of each
+    if (itemClass > 0xffff || (itemSubClass != 0xffffffff && itemSubClass > 0xffff))
+        return;
+
+    AuctionClassMap::const_iterator first, last;
+    if (itemSubClass == 0xffffffff)
+    {
+        first = AuctionsByClass.lower_bound(itemClass << 16);
+        last = AuctionsByClass.upper_bound(itemClass << 16 | 0xffff);
+    }
+    else
+    {
+        first = AuctionsByClass.find(itemClass << 16 | itemSubClass);
+        last = first == AuctionsByClass.end() ? first : std::next(first);
+    }
+
+    for (AuctionClassMap::const_iterator itr = first; itr != last; ++itr)
+        for (const auto& auc : itr->second)
+            auctions.push_back(auc.second);
+}
+
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount)
 {
     for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
@@ -700,16 +773,7 @@ int AuctionEntry::CompareAuctionEntry(uint32 column, const AuctionEntry* auc, Pl
 
             int32 loc_idx = viewPlayer->GetSession()->GetSessionDbLocaleIndex();
 
-            std::string name1 = itemProto1->Name1;
-            sObjectMgr.GetItemLocaleStrings(itemProto1->ItemId, loc_idx, &name1);
-
-            std::string name2 = itemProto2->Name1;
-            sObjectMgr.GetItemLocaleStrings(itemProto2->ItemId, loc_idx, &name2);
-
-            std::wstring wname1, wname2;
-            Utf8toWStr(name1, wname1);
-            Utf8toWStr(name2, wname2);
-            return wname1.compare(wname2);
+            return sAuctionMgr.GetItemNames(itemProto1, loc_idx).name.compare(sAuctionMgr.GetItemNames(itemProto2, loc_idx).name);
         }
         case 6:                                             // minbidbuyout = 6
         {
@@ -791,23 +855,20 @@ bool AuctionSorter::operator()(const AuctionEntry* auc1, const AuctionEntry* auc
     return false;                                           // "equal" by all sorts
 }
 
-void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin,
+void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*>& auctions, AuctionSorter const& sorter, WorldPacket& data, std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin,
         uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull) const
 {
     int loc_idx = _player->GetSession()->GetSessionDbLocaleIndex();
 
+    // keep only the matching auctions, sorting and paging is done on them alone
+    size_t matching = 0;
     for (auto Aentry : auctions)
     {
         Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
         if (!item)
             continue;
 
-        if (isFull)
-        {
-            ++count;
-            Aentry->BuildAuctionInfo(data);
-        }
-        else
+        if (!isFull)
         {
             ItemPrototype const* proto = item->GetProto();
 
@@ -834,6 +895,9 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
             if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
                 continue;
 
+            if (!wsearchedname.empty() && sAuctionMgr.GetItemNames(proto, loc_idx).lowerName.find(wsearchedname) == std::wstring::npos)
+                continue;
+
             if (usable != 0x00)
             {
                 if (_player->CanUseItem(item) != EQUIP_ERR_OK)
@@ -848,21 +912,27 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
                     }
                 }
             }
+        }
 
-            std::string name = proto->Name1;
-            sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
+        auctions[matching++] = Aentry;
+    }
+    auctions.resize(matching);
 
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
-                continue;
+    totalcount = matching;
 
-            if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
-            {
-                ++count;
-                Aentry->BuildAuctionInfo(data);
-            }
-        }
+    // full list is sent at once, otherwise only the requested page has to be in order
+    uint32 listEnd = isFull ? totalcount : std::min(totalcount, listfrom + MAX_AUCTION_ITEMS_CLIENT_UI_PAGE);
+    uint32 listStart = isFull ? 0 : listfrom;
+    if (listStart >= listEnd)
+        return;
 
-        ++totalcount;
+    if (sorter.IsSorted())
+        std::partial_sort(auctions.begin(), auctions.begin() + listEnd, auctions.end(), sorter);
+
+    for (uint32 i = listStart; i < listEnd; ++i)
+    {
+        ++count;
+        auctions[i]->BuildAuctionInfo(data);
     }
 }
 
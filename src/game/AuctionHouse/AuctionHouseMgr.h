@@ -26,6 +26,7 @@ class Item;
 class Player;
 class Unit;
 class WorldPacket;
+struct ItemPrototype;
 
 #define MIN_AUCTION_TIME (12*HOUR)
 #define MAX_AUCTION_SORT 12
@@ -99,17 +100,14 @@ class AuctionHouseObject
 
         typedef std::map<uint32, AuctionEntry*> AuctionEntryMap;
         typedef std::pair<AuctionEntryMap::const_iterator, AuctionEntryMap::const_iterator> AuctionEntryMapBounds;
+        typedef std::map<uint32 /*class << 16 | subclass*/, AuctionEntryMap> AuctionClassMap;
 
         uint32 GetCount() const { return AuctionsMap.size(); }
 
         AuctionEntryMap const& GetAuctions() const { return AuctionsMap; }
         AuctionEntryMapBounds GetAuctionsBounds() const {return AuctionEntryMapBounds(AuctionsMap.begin(), AuctionsMap.end()); }
 
-        void AddAuction(AuctionEntry* ah)
-        {
-            MANGOS_ASSERT(ah);
-            AuctionsMap[ah->Id] = ah;
-        }
+        void AddAuction(AuctionEntry* ah);
 
         AuctionEntry* GetAuction(uint32 id) const
         {
@@ -117,7 +115,10 @@ class AuctionHouseObject
             return itr != AuctionsMap.end() ? itr->second : nullptr;
         }
 
-        bool RemoveAuction(uint32 id) { return !!AuctionsMap.erase(id); }
+        bool RemoveAuction(uint32 id);
+
+        // candidates of an auction search by item class and subclass, 0xffffffff matches any
+        void GetAuctionsByClass(uint32 itemClass, uint32 itemSubClass, std::vector<AuctionEntry*>& auctions) const;
 
         void Update();
 
@@ -126,7 +127,10 @@ class AuctionHouseObject
 
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout = 0, uint32 deposit = 0, Player* pl = nullptr);
     private:
+        static uint32 GetClassKey(AuctionEntry const* auction);
+
         AuctionEntryMap AuctionsMap;
+        AuctionClassMap AuctionsByClass;                    // same auctions, by item class and subclass
 };
 
 class AuctionSorter
@@ -135,12 +139,20 @@ class AuctionSorter
         AuctionSorter(AuctionSorter const& sorter) : m_sort(sorter.m_sort), m_viewPlayer(sorter.m_viewPlayer) {}
         AuctionSorter(uint8* sort, Player* viewPlayer) : m_sort(sort), m_viewPlayer(viewPlayer) {}
         bool operator()(const AuctionEntry* auc1, const AuctionEntry* auc2) const;
+        bool IsSorted() const { return m_sort[0] != MAX_AUCTION_SORT; }
 
     private:
         uint8* m_sort;
         Player* m_viewPlayer;
 };
 
+// item names as used by auction searches
+struct AuctionItemNames
+{
+    std::wstring name;                                      // localized, for sorting
+    std::wstring lowerName;                                 // localized and lower case, for name search
+};
+
 enum AuctionHouseType
 {
     AUCTION_HOUSE_ALLIANCE  = 0,
@@ -181,6 +193,10 @@ class AuctionHouseMgr
         static uint32 GetAuctionHouseTeam(AuctionHouseEntry const* house);
         static AuctionHouseEntry const* GetAuctionHouseEntry(Unit* unit);
 
+        // built on first use of an item and locale, cleared at reload of item locales
+        AuctionItemNames const& GetItemNames(ItemPrototype const* proto, int32 locIdx);
+        void ClearItemNames() { mItemNames.clear(); }
+
     public:
         // load first auction items, because of check if item exists, when loading
         void LoadAuctionItems();
@@ -192,9 +208,12 @@ class AuctionHouseMgr
         void Update();
 
     private:
+        typedef std::unordered_map<uint64 /*locale << 32 | item*/, AuctionItemNames> ItemNamesMap;
+
         AuctionHouseObject  mAuctions[MAX_AUCTION_HOUSE_TYPE];
 
         ItemMap             mAitems;
+        ItemNamesMap        mItemNames;
 };
 
 #define sAuctionMgr MaNGOS::Singleton<AuctionHouseMgr>::Instance()
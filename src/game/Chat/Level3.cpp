@@ -54,6 +54,7 @@
 #include "Server/DBCStores.h"
 #include "AI/EventAI/CreatureEventAIMgr.h"
 #include "Server/SQLStorages.h"
+#include "Database/SQLStorageCache.h"
 #include "Loot/LootMgr.h"
 #include "World/WorldState.h"
 #include "Arena/ArenaTeam.h"
@@ -330,6 +331,20 @@ bool ChatHandler::HandleReloadConfigCommand(char* /*args*/)
     return true;
 }
 
+bool ChatHandler::HandleReloadStorageCacheCommand(char* /*args*/)
+{
+    if (SQLStorageCache::GetDirectory().empty())
+    {
+        SendSysMessage("Storage snapshots are disabled (WorldDatabaseCacheDir).");
+        return true;
+    }
+
+    sLog.outString("Removing storage snapshots...");
+    uint32 count = SQLStorageCache::Invalidate();
+    PSendSysMessage("Removed %u storage snapshot(s), they are rebuilt from the database at next startup.", count);
+    return true;
+}
+
 bool ChatHandler::HandleReloadAreaTriggerTavernCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Tavern Area Triggers...");
@@ -983,6 +998,7 @@ bool ChatHandler::HandleReloadLocalesItemCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Locales Item ... ");
     sObjectMgr.LoadItemLocales();
+    sAuctionMgr.ClearItemNames();
     SendGlobalSysMessage("DB table `locales_item` reloaded.");
     return true;
 }
@@ -4555,6 +4571,7 @@ static bool HandleResetStatsOrLevelHelper(Player* player)
 
     player->SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, DEFAULT_WORLD_OBJECT_SIZE);
     player->SetFloatValue(UNIT_FIELD_COMBATREACH, 1.5f);
+    player->UpdateGridIndex();
 
     player->setFactionForRace(player->getRace());
 
@@ -5941,6 +5958,28 @@ bool ChatHandler::HandleServerPLimitCommand(char* args)
     return true;
 }
 
+bool ChatHandler::HandleServerMapUpdatesCommand(char* args)
+{
+    uint32 limit;
+    if (!ExtractOptUInt32(&args, limit, 10))
+        return false;
+
+    std::vector<Map*> maps = sMapMgr.GetMapsByUpdateCost();
+
+    PSendSysMessage("Loaded maps: %u, most expensive updates:", uint32(maps.size()));
+    for (uint32 i = 0; i < maps.size() && i < limit; ++i)
+    {
+        Map const* map = maps[i];
+        MapUpdateStatistics const& stats = map->GetUpdateStatistics();
+        PSendSysMessage("Map %u (%s) instance %u: avg %.2f ms, last %.2f ms, max %.2f ms, objects %u, players %u",
+                        map->GetId(), map->GetMapName(), map->GetInstanceId(),
+                        stats.averageDuration.count() / 1000.0f, stats.lastDuration.count() / 1000.0f, stats.maxDuration.count() / 1000.0f,
+                        stats.objectCount, stats.playerCount);
+    }
+
+    return true;
+}
+
 bool ChatHandler::HandleCastCommand(char* args)
 {
     if (!*args)
@@ -126,6 +126,13 @@ void Camera::Event_Moved()
     m_source->GetViewPoint().m_grid->AddWorldObject(this);
 }
 
+void Camera::Event_Relocated()
+{
+    MaNGOS::VisibleNotifier notifier(*this, true);
+    Cell::VisitAllObjects(m_source, notifier, m_source->GetVisibilityData().GetVisibilityDistance(), false);
+    notifier.Notify();
+}
+
 void Camera::UpdateVisibilityOf(WorldObject* target) const
 {
     m_owner.UpdateVisibilityOf(m_source, target);
@@ -62,6 +62,7 @@ class Camera
         void Event_AddedToWorld();
         void Event_RemovedFromWorld();
         void Event_Moved();
+        void Event_Relocated();
         void Event_ViewPointVisibilityChanged();
 
         Player& m_owner;
@@ -132,6 +133,12 @@ class ViewPoint
             CameraCall(&Camera::Event_ViewPointVisibilityChanged);
         }
 
+        // viewpoint moved far enough since last visibility update
+        void Event_Relocated()
+        {
+            CameraCall(&Camera::Event_Relocated);
+        }
+
         void Call_UpdateVisibilityForOwner()
         {
             CameraCall(&Camera::UpdateVisibilityForOwner);
@@ -0,0 +1,117 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Entities/GuidFlatSet.h"
+
+bool GuidFlatSet::insert(ObjectGuid guid)
+{
+    if (FindSlot(guid) != NOT_FOUND)
+        return false;
+
+    // table is kept at most half full
+    if ((m_guids.size() + 1) * 2 > m_slots.size())
+        Rehash(std::max(MIN_SLOTS, uint32(m_slots.size() * 2)));
+
+    m_guids.push_back(guid);
+
+    uint32 slot = Hash(guid) & m_mask;
+    while (m_slots[slot])
+        slot = (slot + 1) & m_mask;
+    m_slots[slot] = uint32(m_guids.size());
+    return true;
+}
+
+size_t GuidFlatSet::erase(ObjectGuid guid)
+{
+    uint32 slot = FindSlot(guid);
+    if (slot == NOT_FOUND)
+        return 0;
+
+    uint32 index = m_slots[slot] - 1;
+    RemoveSlot(slot);
+
+    // fill the hole with the last guid and point its slot to the new position
+    if (index + 1 != m_guids.size())
+    {
+        m_guids[index] = m_guids.back();
+        m_slots[FindSlot(m_guids[index])] = index + 1;
+    }
+    m_guids.pop_back();
+    return 1;
+}
+
+GuidFlatSet::iterator GuidFlatSet::erase(const_iterator itr)
+{
+    size_t index = itr - m_guids.begin();
+    erase(*itr);
+    return m_guids.begin() + index;
+}
+
+void GuidFlatSet::clear()
+{
+    m_guids.clear();
+    std::fill(m_slots.begin(), m_slots.end(), 0);
+}
+
+GuidFlatSet::const_iterator GuidFlatSet::find(ObjectGuid guid) const
+{
+    uint32 slot = FindSlot(guid);
+    return slot != NOT_FOUND ? m_guids.begin() + (m_slots[slot] - 1) : m_guids.end();
+}
+
+uint32 GuidFlatSet::FindSlot(ObjectGuid guid) const
+{
+    if (m_guids.empty())
+        return NOT_FOUND;
+
+    for (uint32 slot = Hash(guid) & m_mask; m_slots[slot]; slot = (slot + 1) & m_mask)
+        if (m_guids[m_slots[slot] - 1] == guid)
+            return slot;
+
+    return NOT_FOUND;
+}
+
+void GuidFlatSet::RemoveSlot(uint32 slot)
+{
+    // move following entries of the probe run back, unless that would put them before their home slot
+    uint32 hole = slot;
+    for (uint32 next = (hole + 1) & m_mask; m_slots[next]; next = (next + 1) & m_mask)
+    {
+        uint32 home = Hash(m_guids[m_slots[next] - 1]) & m_mask;
+        if (((next - home) & m_mask) >= ((next - hole) & m_mask))
+        {
+            m_slots[hole] = m_slots[next];
+            hole = next;
+        }
+    }
+    m_slots[hole] = 0;
+}
+
+void GuidFlatSet::Rehash(uint32 slotCount)
+{
+    m_slots.assign(slotCount, 0);
+    m_mask = slotCount - 1;
+
+    for (uint32 index = 0; index < m_guids.size(); ++index)
+    {
+        uint32 slot = Hash(m_guids[index]) & m_mask;
+        while (m_slots[slot])
+            slot = (slot + 1) & m_mask;
+        m_slots[slot] = index + 1;
+    }
+}
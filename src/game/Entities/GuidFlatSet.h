@@ -0,0 +1,73 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_GUIDFLATSET_H
+#define MANGOS_GUIDFLATSET_H
+
+#include "Entities/ObjectGuid.h"
+
+#include <vector>
+
+/**
+ * Unordered set of guids kept in one contiguous array.
+ *
+ * Guids are stored densely, so iteration and copy are plain array walks. Lookups go
+ * through an open addressing table of indexes into that array, with linear probing
+ * and backward shift deletion so no tombstones accumulate. Erasing moves the last
+ * guid into the freed position: erase(iterator) returns an iterator to the same
+ * position, which makes erasing while iterating safe.
+ */
+class GuidFlatSet
+{
+    public:
+        typedef GuidVector::const_iterator const_iterator;
+        typedef const_iterator iterator;
+
+        GuidFlatSet() : m_mask(0) {}
+
+        // returns false when the guid was already in the set
+        bool insert(ObjectGuid guid);
+        // returns the number of removed guids, 0 or 1
+        size_t erase(ObjectGuid guid);
+        iterator erase(const_iterator itr);
+        void clear();
+
+        const_iterator find(ObjectGuid guid) const;
+        size_t count(ObjectGuid guid) const { return FindSlot(guid) != NOT_FOUND ? 1 : 0; }
+
+        const_iterator begin() const { return m_guids.begin(); }
+        const_iterator end() const { return m_guids.end(); }
+        size_t size() const { return m_guids.size(); }
+        bool empty() const { return m_guids.empty(); }
+
+    private:
+        static uint32 const NOT_FOUND = uint32(-1);
+        static uint32 const MIN_SLOTS = 16;
+
+        static uint32 Hash(ObjectGuid guid) { return uint32((guid.GetRawValue() * 0x9E3779B97F4A7C15ULL) >> 32); }
+
+        uint32 FindSlot(ObjectGuid guid) const;
+        void RemoveSlot(uint32 slot);
+        void Rehash(uint32 slotCount);
+
+        GuidVector m_guids;
+        std::vector<uint32> m_slots;                        // index into m_guids + 1, 0 for free slots
+        uint32 m_mask;
+};
+
+#endif
@@ -237,6 +237,41 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target) c
         BuildValuesUpdateBlockForPlayer(data, updateMask, target);
 }
 
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target, UpdateBlockCache& cache) const
+{
+    UpdateMask updateMask;
+    updateMask.SetCount(m_valuesCount);
+
+    _SetUpdateBits(updateMask, target);
+    if (!updateMask.HasData())
+        return;
+
+    bool activateToQuest = false;
+    bool perCasterAuraState = false;
+    _SetViewerUpdateBits(UPDATETYPE_VALUES, updateMask, target, activateToQuest, perCasterAuraState);
+
+    // only the viewer dependent fields are evaluated for every viewer, the rest of the block is shared
+    std::vector<uint32> viewerValues;
+    for (uint16 index = 0; index < m_valuesCount; ++index)
+        if (updateMask.GetBit(index) && IsViewerDependentUpdateField(index))
+            viewerValues.push_back(_GetUpdateFieldValue(index, target, activateToQuest, perCasterAuraState));
+
+    if (ByteBuffer const* block = cache.Find(updateMask, viewerValues))
+    {
+        data.AddUpdateBlock(*block);
+        return;
+    }
+
+    ByteBuffer buf(500);
+
+    buf << uint8(UPDATETYPE_VALUES);
+    buf << GetPackGUID();
+
+    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+    data.AddUpdateBlock(buf);
+    cache.Add(updateMask, std::move(viewerValues), std::move(buf));
+}
+
 void Object::BuildValuesUpdateBlockForPlayerWithFlags(UpdateData& data, Player* target, UpdateFieldFlags flags) const
 {
     UpdateMask updateMask;
@@ -415,22 +450,62 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
 
     bool IsActivateToQuest = false;
     bool IsPerCasterAuraState = false;
+    _SetViewerUpdateBits(updatetype, *updateMask, target, IsActivateToQuest, IsPerCasterAuraState);
 
+    MANGOS_ASSERT(updateMask && updateMask->GetCount() == m_valuesCount);
+
+    *data << (uint8)updateMask->GetBlockCount();
+    data->append(updateMask->GetMask(), updateMask->GetLength());
+
+    // 2 specialized loops for speed optimization in non-unit case
+    if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
+    {
+        for (uint16 index = 0; index < m_valuesCount; ++index)
+            if (updateMask->GetBit(index))
+                *data << _GetUnitUpdateFieldValue(index, target, IsPerCasterAuraState);
+    }
+    else if (isType(TYPEMASK_CORPSE))                       // corpse case
+    {
+        for (uint16 index = 0; index < m_valuesCount; ++index)
+            if (updateMask->GetBit(index))
+                *data << _GetCorpseUpdateFieldValue(index, target);
+    }
+    else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
+    {
+        for (uint16 index = 0; index < m_valuesCount; ++index)
+            if (updateMask->GetBit(index))
+                *data << _GetGameObjectUpdateFieldValue(index, IsActivateToQuest);
+    }
+    else                                                    // other objects case (no special index checks)
+    {
+        for (uint16 index = 0; index < m_valuesCount; ++index)
+        {
+            if (updateMask->GetBit(index))
+            {
+                // send in current format (float as float, uint32 as uint32)
+                *data << m_uint32Values[index];
+            }
+        }
+    }
+}
+
+void Object::_SetViewerUpdateBits(uint8 updatetype, UpdateMask& updateMask, Player* target, bool& activateToQuest, bool& perCasterAuraState) const
+{
     if (updatetype == UPDATETYPE_CREATE_OBJECT || updatetype == UPDATETYPE_CREATE_OBJECT2)
     {
         if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
         {
             if (((GameObject*)this)->ActivateToQuest(target) || target->IsGameMaster())
-                IsActivateToQuest = true;
+                activateToQuest = true;
 
-            updateMask->SetBit(GAMEOBJECT_DYN_FLAGS);
+            updateMask.SetBit(GAMEOBJECT_DYN_FLAGS);
         }
         else if (isType(TYPEMASK_UNIT))
         {
             if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
             {
-                IsPerCasterAuraState = true;
-                updateMask->SetBit(UNIT_FIELD_AURASTATE);
+                perCasterAuraState = true;
+                updateMask.SetBit(UNIT_FIELD_AURASTATE);
             }
         }
     }
@@ -439,372 +514,370 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
         if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
         {
             if (((GameObject*)this)->ActivateToQuest(target) || target->IsGameMaster())
-                IsActivateToQuest = true;
+                activateToQuest = true;
 
-            updateMask->SetBit(GAMEOBJECT_DYN_FLAGS);
-            updateMask->SetBit(GAMEOBJECT_ANIMPROGRESS);
+            updateMask.SetBit(GAMEOBJECT_DYN_FLAGS);
+            updateMask.SetBit(GAMEOBJECT_ANIMPROGRESS);
         }
         else if (isType(TYPEMASK_UNIT))
         {
             if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
             {
-                IsPerCasterAuraState = true;
-                updateMask->SetBit(UNIT_FIELD_AURASTATE);
+                perCasterAuraState = true;
+                updateMask.SetBit(UNIT_FIELD_AURASTATE);
             }
         }
     }
+}
 
-    MANGOS_ASSERT(updateMask && updateMask->GetCount() == m_valuesCount);
+bool Object::IsViewerDependentUpdateField(uint16 index) const
+{
+    if (isType(TYPEMASK_UNIT))
+    {
+        switch (index)
+        {
+            case UNIT_NPC_FLAGS:
+            case UNIT_FIELD_AURASTATE:
+            case UNIT_FIELD_HEALTH:
+            case UNIT_FIELD_MAXHEALTH:
+            case UNIT_FIELD_FLAGS:
+            case UNIT_DYNAMIC_FLAGS:
+            case UNIT_FIELD_FACTIONTEMPLATE:
+                return true;
+            default:
+                return false;
+        }
+    }
 
-    *data << (uint8)updateMask->GetBlockCount();
-    data->append(updateMask->GetMask(), updateMask->GetLength());
+    if (isType(TYPEMASK_CORPSE))
+        return index == CORPSE_FIELD_BYTES_1;
 
-    // 2 specialized loops for speed optimization in non-unit case
-    if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
+    if (isType(TYPEMASK_GAMEOBJECT))
+        return index == GAMEOBJECT_DYN_FLAGS;
+
+    return false;
+}
+
+uint32 Object::_GetUpdateFieldValue(uint16 index, Player* target, bool activateToQuest, bool perCasterAuraState) const
+{
+    if (isType(TYPEMASK_UNIT))
+        return _GetUnitUpdateFieldValue(index, target, perCasterAuraState);
+
+    if (isType(TYPEMASK_CORPSE))
+        return _GetCorpseUpdateFieldValue(index, target);
+
+    if (isType(TYPEMASK_GAMEOBJECT))
+        return _GetGameObjectUpdateFieldValue(index, activateToQuest);
+
+    return m_uint32Values[index];
+}
+
+uint32 Object::_GetUnitUpdateFieldValue(uint16 index, Player* target, bool perCasterAuraState) const
+{
+    if (index == UNIT_NPC_FLAGS)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        uint32 appendValue = m_uint32Values[index];
+
+        if (GetTypeId() == TYPEID_UNIT)
         {
-            if (updateMask->GetBit(index))
+            if (appendValue & UNIT_NPC_FLAG_TRAINER)
             {
-                if (index == UNIT_NPC_FLAGS)
-                {
-                    uint32 appendValue = m_uint32Values[index];
+                if (!((Creature*)this)->IsTrainerOf(target, false))
+                    appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
+            }
 
-                    if (GetTypeId() == TYPEID_UNIT)
-                    {
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->IsTrainerOf(target, false))
-                                appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
-                        {
-                            QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
-                            {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanSeeStartQuest(pQuest))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
-                            }
-
-                            bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
-                            {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanRewardQuest(pQuest, false))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
-                            }
-                        }
-                    }
+            if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
+            {
+                if (target->getClass() != CLASS_HUNTER)
+                    appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
+            }
 
-                    *data << uint32(appendValue);
-                }
-                else if (index == UNIT_FIELD_AURASTATE)
+            if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
+            {
+                QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
+                for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
                 {
-                    if (IsPerCasterAuraState)
+                    Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                    if (target->CanSeeStartQuest(pQuest))
                     {
-                        // IsPerCasterAuraState set if related pet caster aura state set already
-                        if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
-                            *data << m_uint32Values[index];
-                        else
-                            *data << (m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1)));
+                        appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                        break;
                     }
-                    else
-                        *data << m_uint32Values[index];
-                }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-                {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
                 }
 
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                         (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
-                {
-                    *data << uint32(m_floatValues[index]);
-                }
-                else if (index == UNIT_FIELD_HEALTH || index == UNIT_FIELD_MAXHEALTH)
+                bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
+                for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
                 {
-                    uint32 value = m_uint32Values[index];
-
-                    // Fog of War: replace absolute health values with percentages for non-allied units according to settings
-                    if (!static_cast<const Unit*>(this)->IsFogOfWarVisibleHealth(target) &&
-                        !target->CanSeeSpecialInfoOf(static_cast<const Unit*>(this)))
+                    Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                    if (target->CanRewardQuest(pQuest, false))
                     {
-                        switch (index)
-                        {
-                            case UNIT_FIELD_HEALTH:     value = uint32(ceil((100.0 * value) / m_uint32Values[UNIT_FIELD_MAXHEALTH]));   break;
-                            case UNIT_FIELD_MAXHEALTH:  value = 100;                                                                    break;
-                        }
+                        appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                        break;
                     }
-
-                    *data << value;
                 }
-                else if (index == UNIT_FIELD_FLAGS)
-                {
-                    uint32 value = m_uint32Values[index];
+            }
+        }
 
-                    // For gamemasters in GM mode:
-                    if (target->IsGameMaster())
-                    {
-                        // Gamemasters should be always able to select units - remove not selectable flag:
-                        value &= ~UNIT_FLAG_UNINTERACTIBLE;
-                    }
+        return uint32(appendValue);
+    }
+    else if (index == UNIT_FIELD_AURASTATE)
+    {
+        if (perCasterAuraState)
+        {
+            // IsPerCasterAuraState set if related pet caster aura state set already
+            if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
+                return m_uint32Values[index];
+            else
+                return (m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1)));
+        }
+        else
+            return m_uint32Values[index];
+    }
+    // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+    else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+    {
+        // convert from float to uint32 and send
+        return uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+    }
 
-                    // Client bug workaround: Fix for missing chat channels when resuming taxi flight on login
-                    // Client does not send any chat joining attempts by itself when taxi flag is on
-                    if (target == this && (value & UNIT_FLAG_TAXI_FLIGHT))
-                    {
-                        if (sWorld.getConfig(CONFIG_BOOL_TAXI_FLIGHT_CHAT_FIX))
-                            if (WorldSession* session = static_cast<Player const*>(this)->GetSession())
-                                if (!session->IsInitialZoneUpdated())
-                                    value &= ~UNIT_FLAG_TAXI_FLIGHT;
-                    }
+    // there are some float values which may be negative or can't get negative due to other checks
+    else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
+             (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+             (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+             (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
+    {
+        return uint32(m_floatValues[index]);
+    }
+    else if (index == UNIT_FIELD_HEALTH || index == UNIT_FIELD_MAXHEALTH)
+    {
+        uint32 value = m_uint32Values[index];
 
-                    // On login/reconnect: delay combat state application at client UI to not interfere with secure frames init
-                    if (target == this && (value & UNIT_FLAG_IN_COMBAT))
-                    {
-                        if (static_cast<Player const*>(this)->GetSession()->PlayerLoading())
-                            value &= ~UNIT_FLAG_IN_COMBAT;
-                    }
+        // Fog of War: replace absolute health values with percentages for non-allied units according to settings
+        if (!static_cast<const Unit*>(this)->IsFogOfWarVisibleHealth(target) &&
+            !target->CanSeeSpecialInfoOf(static_cast<const Unit*>(this)))
+        {
+            switch (index)
+            {
+                case UNIT_FIELD_HEALTH:     value = uint32(ceil((100.0 * value) / m_uint32Values[UNIT_FIELD_MAXHEALTH]));   break;
+                case UNIT_FIELD_MAXHEALTH:  value = 100;                                                                    break;
+            }
+        }
 
-                    *data << value;
-                }
-                // Hide lootable animation for unallowed players
-                // Handle tapped flag
-                // Hide special-info for non empathy-casters,
-                else if (index == UNIT_DYNAMIC_FLAGS)
-                {
-                    uint32 dynflagsValue = m_uint32Values[index];
+        return value;
+    }
+    else if (index == UNIT_FIELD_FLAGS)
+    {
+        uint32 value = m_uint32Values[index];
 
-                    // Checking SPELL_AURA_EMPATHY and caster
-                    if (dynflagsValue & UNIT_DYNFLAG_SPECIALINFO && static_cast<const Unit*>(this)->IsAlive())
-                    {
-                        bool bIsEmpathy = false;
-                        bool bIsCaster = false;
-                        Unit::AuraList const& mAuraEmpathy = static_cast<const Unit*>(this)->GetAurasByType(SPELL_AURA_EMPATHY);
-                        for (Unit::AuraList::const_iterator itr = mAuraEmpathy.begin(); !bIsCaster && itr != mAuraEmpathy.end(); ++itr)
-                        {
-                            bIsEmpathy = true;              // Empathy by aura set
-                            if ((*itr)->GetCasterGuid() == target->GetObjectGuid())
-                                bIsCaster = true;           // target is the caster of an empathy aura
-                        }
-                        if (bIsEmpathy && !bIsCaster)       // Empathy by aura, but target is not the caster
-                            dynflagsValue &= ~UNIT_DYNFLAG_SPECIALINFO;
-                    }
+        // For gamemasters in GM mode:
+        if (target->IsGameMaster())
+        {
+            // Gamemasters should be always able to select units - remove not selectable flag:
+            value &= ~UNIT_FLAG_UNINTERACTIBLE;
+        }
 
-                    // Hide lootable animation for unallowed players
-                    // Handle tapped flag
-                    if (GetTypeId() == TYPEID_UNIT)
-                    {
-                        Creature* creature = (Creature*)this;
-                        bool setTapFlags = false;
-
-                        if (creature->IsAlive())
-                        {
-                            // creature is alive so, not lootable
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
-
-                            if (creature->IsInCombat())
-                            {
-                                // as creature is in combat we have to manage tap flags
-                                setTapFlags = true;
-                            }
-                            else
-                            {
-                                // creature is not in combat so its not tapped
-                                dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
-                                //sLog.outString(">> %s is not in combat so not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                            }
-                        }
-                        else
-                        {
-                            // check m_loot flag
-                            if (creature->m_loot && creature->m_loot->CanLoot(target))
-                            {
-                                // creature is dead and this player can loot it
-                                dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
-                                //sLog.outString(">> %s is lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                            }
-                            else
-                            {
-                                // creature is dead but this player cannot loot it
-                                dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
-                                //sLog.outString(">> %s is not lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                            }
-
-                            // as creature is died we have to manage tap flags
-                            setTapFlags = true;
-                        }
-
-                        // check tap flags
-                        if (setTapFlags)
-                        {
-                            if (creature->IsTappedBy(target))
-                            {
-                                // creature is in combat or died and tapped by this player
-                                dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
-                                //sLog.outString(">> %s is tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                            }
-                            else
-                            {
-                                // creature is in combat or died but not tapped by this player
-                                dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
-                                //sLog.outString(">> %s is not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                            }
-                        }
-                    }
+        // Client bug workaround: Fix for missing chat channels when resuming taxi flight on login
+        // Client does not send any chat joining attempts by itself when taxi flag is on
+        if (target == this && (value & UNIT_FLAG_TAXI_FLIGHT))
+        {
+            if (sWorld.getConfig(CONFIG_BOOL_TAXI_FLIGHT_CHAT_FIX))
+                if (WorldSession* session = static_cast<Player const*>(this)->GetSession())
+                    if (!session->IsInitialZoneUpdated())
+                        value &= ~UNIT_FLAG_TAXI_FLIGHT;
+        }
 
-                    if (GetTypeId() == TYPEID_UNIT || GetTypeId() == TYPEID_PLAYER)
-                    {
-                        Unit const* unit = static_cast<const Unit*>(this); // hunters mark effects should only be visible to owners and not all players
-                        if (!unit->HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetObjectGuid()))
-                            dynflagsValue &= ~UNIT_DYNFLAG_TRACK_UNIT;
-                    }
+        // On login/reconnect: delay combat state application at client UI to not interfere with secure frames init
+        if (target == this && (value & UNIT_FLAG_IN_COMBAT))
+        {
+            if (static_cast<Player const*>(this)->GetSession()->PlayerLoading())
+                value &= ~UNIT_FLAG_IN_COMBAT;
+        }
 
-                    *data << dynflagsValue;
-                }
-                else if (index == UNIT_FIELD_FACTIONTEMPLATE)
-                {
-                    uint32 value = m_uint32Values[index];
+        return value;
+    }
+    // Hide lootable animation for unallowed players
+    // Handle tapped flag
+    // Hide special-info for non empathy-casters,
+    else if (index == UNIT_DYNAMIC_FLAGS)
+    {
+        uint32 dynflagsValue = m_uint32Values[index];
 
-                    // [XFACTION]: Alter faction if detected crossfaction group interaction when updating faction field:
-                    if (this != target && GetTypeId() == TYPEID_PLAYER)
-                    {
-                        Player const* thisPlayer = static_cast<Player const*>(this);
-
-                        if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP) && target->IsInGroup(thisPlayer))
-                        {
-                            const uint32 targetTeam = target->GetTeam();
-
-                            if (thisPlayer->GetTeam() != targetTeam && value == Player::getFactionForRace(thisPlayer->getRace()))
-                            {
-                                switch (targetTeam)
-                                {
-                                    case ALLIANCE:  value = 1054;   break;  // "Alliance Generic"
-                                    case HORDE:     value = 1495;   break;  // "Horde Generic"
-                                }
-                            }
-                        }
-                    }
+        // Checking SPELL_AURA_EMPATHY and caster
+        if (dynflagsValue & UNIT_DYNFLAG_SPECIALINFO && static_cast<const Unit*>(this)->IsAlive())
+        {
+            bool bIsEmpathy = false;
+            bool bIsCaster = false;
+            Unit::AuraList const& mAuraEmpathy = static_cast<const Unit*>(this)->GetAurasByType(SPELL_AURA_EMPATHY);
+            for (Unit::AuraList::const_iterator itr = mAuraEmpathy.begin(); !bIsCaster && itr != mAuraEmpathy.end(); ++itr)
+            {
+                bIsEmpathy = true;              // Empathy by aura set
+                if ((*itr)->GetCasterGuid() == target->GetObjectGuid())
+                    bIsCaster = true;           // target is the caster of an empathy aura
+            }
+            if (bIsEmpathy && !bIsCaster)       // Empathy by aura, but target is not the caster
+                dynflagsValue &= ~UNIT_DYNFLAG_SPECIALINFO;
+        }
+
+        // Hide lootable animation for unallowed players
+        // Handle tapped flag
+        if (GetTypeId() == TYPEID_UNIT)
+        {
+            Creature* creature = (Creature*)this;
+            bool setTapFlags = false;
 
-                    *data << value;
+            if (creature->IsAlive())
+            {
+                // creature is alive so, not lootable
+                dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
+
+                if (creature->IsInCombat())
+                {
+                    // as creature is in combat we have to manage tap flags
+                    setTapFlags = true;
                 }
-                else                                        // Unhandled index, just send
+                else
                 {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
+                    // creature is not in combat so its not tapped
+                    dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
+                    //sLog.outString(">> %s is not in combat so not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                 }
             }
-        }
-    }
-    else if (isType(TYPEMASK_CORPSE))                       // corpse case
-    {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
-        {
-            if (updateMask->GetBit(index))
+            else
             {
-                if (index == CORPSE_FIELD_BYTES_1)
+                // check m_loot flag
+                if (creature->m_loot && creature->m_loot->CanLoot(target))
                 {
-                    uint32 value = m_uint32Values[index];
-
-                    // [XFACTION]: Alter race field if detected crossfaction group interaction:
-                    if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP))
-                    {
-                        Corpse const* thisCorpse = static_cast<Corpse const*>(this);
-                        ObjectGuid const& ownerGuid = thisCorpse->GetOwnerGuid();
-                        Group const* targetGroup = target->GetGroup();
-
-                        if (ownerGuid != target->GetObjectGuid() && targetGroup && targetGroup->IsMember(ownerGuid))
-                        {
-                            const uint8 targetRace = target->getRace();
+                    // creature is dead and this player can loot it
+                    dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
+                    //sLog.outString(">> %s is lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
+                }
+                else
+                {
+                    // creature is dead but this player cannot loot it
+                    dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
+                    //sLog.outString(">> %s is not lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
+                }
 
-                            if (Player::TeamForRace(thisCorpse->getRace()) != Player::TeamForRace(targetRace))
-                                value = ((value &~ uint32(0xFF << 8)) | (uint32(targetRace) << 8));
-                        }
-                    }
+                // as creature is died we have to manage tap flags
+                setTapFlags = true;
+            }
 
-                    *data << value;
+            // check tap flags
+            if (setTapFlags)
+            {
+                if (creature->IsTappedBy(target))
+                {
+                    // creature is in combat or died and tapped by this player
+                    dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
+                    //sLog.outString(">> %s is tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                 }
                 else
-                    *data << m_uint32Values[index];         // other cases
+                {
+                    // creature is in combat or died but not tapped by this player
+                    dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
+                    //sLog.outString(">> %s is not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
+                }
             }
         }
+
+        if (GetTypeId() == TYPEID_UNIT || GetTypeId() == TYPEID_PLAYER)
+        {
+            Unit const* unit = static_cast<const Unit*>(this); // hunters mark effects should only be visible to owners and not all players
+            if (!unit->HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetObjectGuid()))
+                dynflagsValue &= ~UNIT_DYNFLAG_TRACK_UNIT;
+        }
+
+        return dynflagsValue;
     }
-    else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
+    else if (index == UNIT_FIELD_FACTIONTEMPLATE)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        uint32 value = m_uint32Values[index];
+
+        // [XFACTION]: Alter faction if detected crossfaction group interaction when updating faction field:
+        if (this != target && GetTypeId() == TYPEID_PLAYER)
         {
-            if (updateMask->GetBit(index))
+            Player const* thisPlayer = static_cast<Player const*>(this);
+
+            if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP) && target->IsInGroup(thisPlayer))
             {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYN_FLAGS)
-                {
-                    // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
-                    //      most likely related to "can enter map" and then should be 0 if can not enter
+                const uint32 targetTeam = target->GetTeam();
 
-                    if (IsActivateToQuest)
+                if (thisPlayer->GetTeam() != targetTeam && value == Player::getFactionForRace(thisPlayer->getRace()))
+                {
+                    switch (targetTeam)
                     {
-                        GameObject const* gameObject = static_cast<GameObject const*>(this);
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                *data << uint16(0);
-                                break;
-                            case GAMEOBJECT_TYPE_CHEST:
-                                if (gameObject->GetLootState() == GO_READY || gameObject->GetLootState() == GO_ACTIVATED)
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                else
-                                    *data << uint16(0);
-                                *data << uint16(0);
-                                break;
-                            case GAMEOBJECT_TYPE_GENERIC:
-                            case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                *data << uint16(0);
-                                break;
-                            default:
-                                *data << uint32(0);         // unknown, not happen.
-                                break;
-                        }
+                        case ALLIANCE:  value = 1054;   break;  // "Alliance Generic"
+                        case HORDE:     value = 1495;   break;  // "Horde Generic"
                     }
-                    else
-                        *data << uint32(0);                 // disable quest object
                 }
-                else
-                    *data << m_uint32Values[index];         // other cases
             }
         }
+
+        return value;
     }
-    else                                                    // other objects case (no special index checks)
+    else                                        // Unhandled index, just send
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        // send in current format (float as float, uint32 as uint32)
+        return m_uint32Values[index];
+    }
+}
+
+uint32 Object::_GetCorpseUpdateFieldValue(uint16 index, Player* target) const
+{
+    if (index == CORPSE_FIELD_BYTES_1)
+    {
+        uint32 value = m_uint32Values[index];
+
+        // [XFACTION]: Alter race field if detected crossfaction group interaction:
+        if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP))
         {
-            if (updateMask->GetBit(index))
+            Corpse const* thisCorpse = static_cast<Corpse const*>(this);
+            ObjectGuid const& ownerGuid = thisCorpse->GetOwnerGuid();
+            Group const* targetGroup = target->GetGroup();
+
+            if (ownerGuid != target->GetObjectGuid() && targetGroup && targetGroup->IsMember(ownerGuid))
             {
-                // send in current format (float as float, uint32 as uint32)
-                *data << m_uint32Values[index];
+                const uint8 targetRace = target->getRace();
+
+                if (Player::TeamForRace(thisCorpse->getRace()) != Player::TeamForRace(targetRace))
+                    value = ((value &~ uint32(0xFF << 8)) | (uint32(targetRace) << 8));
             }
         }
+
+        return value;
+    }
+    else
+        return m_uint32Values[index];             // other cases
+}
+
+uint32 Object::_GetGameObjectUpdateFieldValue(uint16 index, bool activateToQuest) const
+{
+    // send in current format (float as float, uint32 as uint32)
+    if (index != GAMEOBJECT_DYN_FLAGS)
+        return m_uint32Values[index];                       // other cases
+
+    // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
+    //      most likely related to "can enter map" and then should be 0 if can not enter
+    // hi word of the field is always 0
+
+    if (!activateToQuest)
+        return 0;                                           // disable quest object
+
+    GameObject const* gameObject = static_cast<GameObject const*>(this);
+    switch (gameObject->GetGoType())
+    {
+        case GAMEOBJECT_TYPE_QUESTGIVER:
+            return GO_DYNFLAG_LO_ACTIVATE;
+        case GAMEOBJECT_TYPE_CHEST:
+            if (gameObject->GetLootState() == GO_READY || gameObject->GetLootState() == GO_ACTIVATED)
+                return GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+            return 0;
+        case GAMEOBJECT_TYPE_GENERIC:
+        case GAMEOBJECT_TYPE_SPELL_FOCUS:
+        case GAMEOBJECT_TYPE_GOOBER:
+            return GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+        default:
+            return 0;                                       // unknown, not happen.
     }
 }
 
@@ -1164,7 +1237,7 @@ bool Object::PrintEntryError(char const* descr) const
 }
 
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, UpdateBlockCache* cache) const
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -1175,7 +1248,10 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(iter->second, iter->first);
+    if (cache)
+        BuildValuesUpdateBlockForPlayer(iter->second, iter->first, *cache);
+    else
+        BuildValuesUpdateBlockForPlayer(iter->second, iter->first);
 }
 
 void Object::AddToClientUpdateList()
@@ -1296,7 +1372,10 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
     m_position.o = orientation;
 
     if (isType(TYPEMASK_UNIT))
+    {
         m_movementInfo.ChangePosition(x, y, z, orientation);
+        UpdateGridIndex();
+    }
 }
 
 void WorldObject::Relocate(float x, float y, float z)
@@ -1306,7 +1385,27 @@ void WorldObject::Relocate(float x, float y, float z)
     m_position.z = z;
 
     if (isType(TYPEMASK_UNIT))
+    {
         m_movementInfo.ChangePosition(x, y, z, GetOrientation());
+        UpdateGridIndex();
+    }
+}
+
+void WorldObject::UpdateGridIndex()
+{
+    // only unit searchers use the index, other objects keep unknown positions there
+    float reach = std::max(GetObjectBoundingRadius(), GetCombatReach());
+    switch (GetTypeId())
+    {
+        case TYPEID_UNIT:
+            static_cast<Creature*>(this)->GetGridRef().updateIndex(m_position.x, m_position.y, reach);
+            break;
+        case TYPEID_PLAYER:
+            static_cast<Player*>(this)->GetGridRef().updateIndex(m_position.x, m_position.y, reach);
+            break;
+        default:
+            break;
+    }
 }
 
 void WorldObject::SetOrientation(float orientation)
@@ -2584,6 +2683,7 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
+    UpdateBlockCache i_blockCache;                          // same delta is serialized once for all viewers
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj)
     {
         // send self fields changes in another way, otherwise
@@ -2594,7 +2694,7 @@ struct WorldObjectChangeAccumulator
 #ifdef ENABLE_PLAYERBOTS
             if (plr->isRealPlayer())
 #endif
-            i_object.BuildUpdateDataForPlayer(plr, i_updateDatas);
+            i_object.BuildUpdateDataForPlayer(plr, i_updateDatas, &i_blockCache);
         }
     }
 
@@ -2608,7 +2708,7 @@ struct WorldObjectChangeAccumulator
             {
 #endif
             if (owner != &i_object && owner->HasAtClient(&i_object))
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, &i_blockCache);
 #ifdef ENABLE_PLAYERBOTS
             }
 #endif
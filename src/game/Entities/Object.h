@@ -415,6 +415,7 @@ class Object
         void SendForcedObjectUpdate();
 
         void BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target, UpdateBlockCache& cache) const;
         void BuildValuesUpdateBlockForPlayerWithFlags(UpdateData& data, Player* target, UpdateFieldFlags flags) const;
         void BuildValuesUpdateBlockForPlayer(UpdateData& data, UpdateMask& updateMask, Player* target) const;
         void BuildForcedValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
@@ -638,7 +639,16 @@ class Object
 
         void BuildMovementUpdate(ByteBuffer* data, uint8 updateFlags) const;
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const;
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, UpdateBlockCache* cache = nullptr) const;
+
+        // bits BuildValuesUpdate adds on top of the changed fields, activateToQuest/perCasterAuraState tell how they are sent to target
+        void _SetViewerUpdateBits(uint8 updatetype, UpdateMask& updateMask, Player* target, bool& activateToQuest, bool& perCasterAuraState) const;
+        // fields whose sent value may differ between viewers, all others are shared by every viewer
+        bool IsViewerDependentUpdateField(uint16 index) const;
+        uint32 _GetUpdateFieldValue(uint16 index, Player* target, bool activateToQuest, bool perCasterAuraState) const;
+        uint32 _GetUnitUpdateFieldValue(uint16 index, Player* target, bool perCasterAuraState) const;
+        uint32 _GetCorpseUpdateFieldValue(uint16 index, Player* target) const;
+        uint32 _GetGameObjectUpdateFieldValue(uint16 index, bool activateToQuest) const;
 
         uint16 m_objectType;
 
@@ -911,6 +921,8 @@ class WorldObject : public Object
 
         void Relocate(float x, float y, float z, float orientation);
         void Relocate(float x, float y, float z);
+        // refreshes the position and reach grid searchers prefilter units with, see GridRefIndex
+        void UpdateGridIndex();
 
         void SetOrientation(float orientation);
 
@@ -23,6 +23,7 @@
 #include "Entities/ItemPrototype.h"
 #include "Entities/Unit.h"
 #include "Entities/Item.h"
+#include "Entities/GuidFlatSet.h"
 
 #include "Database/DatabaseEnv.h"
 #include "Quests/QuestDef.h"
@@ -2107,10 +2108,10 @@ class Player : public Unit
         Object* GetObjectByTypeMask(ObjectGuid guid, TypeMask typemask);
 
         // currently visible objects at player client
-        bool HasAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.find(u->GetObjectGuid()) != m_clientGUIDs.end(); }
+        bool HasAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.count(u->GetObjectGuid()); }
         void AddAtClient(WorldObject* target);
         void RemoveAtClient(WorldObject* target);
-        GuidSet& GetClientGuids() { return m_clientGUIDs; }
+        GuidFlatSet& GetClientGuids() { return m_clientGUIDs; }
 
         bool IsVisibleInGridForPlayer(Player* pl) const override;
         bool IsVisibleGloballyFor(Player* u) const;
@@ -2618,12 +2619,13 @@ class Player : public Unit
         Spell* m_modsSpell;
         std::set<SpellModifierPair>* m_consumedMods;
 
-        GuidSet m_clientGUIDs;
+        GuidFlatSet m_clientGUIDs;
 
         // Recruit-A-Friend
         uint8 m_grantableLevels;
 
         std::unordered_map<uint32, TimePoint> m_enteredInstances;
+        bool m_enteredInstancesChanged;                     // m_enteredInstances differ from the db
         uint32 m_createdInstanceClearTimer;
 
         std::map<uint32, ObjectGuid> m_followAngles;
@@ -364,6 +364,7 @@ Unit::Unit() :
     // m_AurasCheck = 2000;
     // m_removeAuraTimer = 4;
     m_spellAuraHoldersUpdateIterator = m_spellAuraHolders.end();
+    m_procAuraHolders.SetGeneration(sSpellMgr.GetSpellProcEventGeneration());
     m_AuraFlags = 0;
 
     m_Visibility = VISIBILITY_ON;
@@ -2547,10 +2548,10 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* caster, SpellSchoolMask schoolMa
         if (!IsPassiveSpell(spellProto))
         {
             // Reduce shield amount
-            mod->m_amount -= currentAbsorb;
+            (*i)->SetAmount(mod->m_amount - currentAbsorb);
             if (dropCharge)
                 if ((*i)->GetHolder()->DropAuraCharge())
-                    mod->m_amount = 0;
+                    (*i)->SetAmount(0);
             // Need remove it later
             if (mod->m_amount <= 0)
                 existExpired = true;
@@ -2609,7 +2610,7 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* caster, SpellSchoolMask schoolMa
 
         (*i)->OnManaAbsorb(currentAbsorb);
 
-        (*i)->GetModifier()->m_amount -= currentAbsorb;
+        (*i)->SetAmount((*i)->GetModifier()->m_amount - currentAbsorb);
         if ((*i)->GetModifier()->m_amount <= 0)
         {
             RemoveAurasDueToSpell((*i)->GetId());
@@ -4756,11 +4757,16 @@ void Unit::DeMorph()
     SetDisplayId(GetNativeDisplayId());
 }
 
+// shorter lists are summed faster than looked up in the aggregate cache
+static size_t const AURA_AGGREGATE_MIN_AURAS = 3;
+
 int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
-
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (mTotalAuraList.size() >= AURA_AGGREGATE_MIN_AURAS)
+        return GetAuraAggregate(auratype).total;
+
+    int32 modifier = 0;
     for (auto i : mTotalAuraList)
         modifier += i->GetModifier()->m_amount;
 
@@ -4769,15 +4775,48 @@ int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
-    float multiplier = 1.0f;
-
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (mTotalAuraList.size() >= AURA_AGGREGATE_MIN_AURAS)
+        return GetAuraAggregate(auratype).multiplier;
+
+    float multiplier = 1.0f;
     for (auto i : mTotalAuraList)
         multiplier *= (100.0f + i->GetModifier()->m_amount) / 100.0f;
 
     return multiplier;
 }
 
+Unit::AuraAggregate const& Unit::GetAuraAggregate(AuraType auratype) const
+{
+    for (AuraAggregate const& aggregate : m_auraAggregates)
+        if (aggregate.type == auratype)
+            return aggregate;
+
+    // same order of operations as the uncached sum and product
+    AuraAggregate aggregate = { auratype, 0, 1.0f };
+    for (auto i : GetAurasByType(auratype))
+    {
+        aggregate.total += i->GetModifier()->m_amount;
+        aggregate.multiplier *= (100.0f + i->GetModifier()->m_amount) / 100.0f;
+    }
+
+    m_auraAggregates.push_back(aggregate);
+    return m_auraAggregates.back();
+}
+
+void Unit::InvalidateAuraAggregate(AuraType auratype)
+{
+    for (size_t i = 0; i < m_auraAggregates.size(); ++i)
+    {
+        if (m_auraAggregates[i].type == auratype)
+        {
+            m_auraAggregates[i] = m_auraAggregates.back();
+            m_auraAggregates.pop_back();
+            return;
+        }
+    }
+}
+
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
 {
     int32 modifier = 0;
@@ -5114,6 +5153,7 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
     holder->_AddSpellAuraHolder();
     holder->SetCreationDelayFlag();
     m_spellAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
+    m_procAuraHolders.Insert(holder);
 
     for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
@@ -5138,7 +5178,10 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
 void Unit::AddAuraToModList(Aura* aura)
 {
     if (aura->GetModifier()->m_auraname < TOTAL_AURAS)
+    {
         m_modAuras[aura->GetModifier()->m_auraname].push_back(aura);
+        InvalidateAuraAggregate(aura->GetModifier()->m_auraname);
+    }
 }
 
 void Unit::RemoveRankAurasDueToSpell(uint32 spellId)
@@ -5663,6 +5706,7 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
         if (itr->second == holder)
         {
             m_spellAuraHolders.erase(itr);
+            m_procAuraHolders.Remove(holder);
             break;
         }
     }
@@ -5726,6 +5770,7 @@ void Unit::RemoveAura(Aura* Aur, AuraRemoveMode mode)
     if (Aur->GetModifier()->m_auraname < TOTAL_AURAS)
     {
         m_modAuras[Aur->GetModifier()->m_auraname].remove(Aur);
+        InvalidateAuraAggregate(Aur->GetModifier()->m_auraname);
     }
 
     // Set remove mode
@@ -10722,6 +10767,7 @@ void Unit::UpdateModelData()
         SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, GetObjectScale() * modelInfo->bounding_radius);
 
         SetFloatValue(UNIT_FIELD_COMBATREACH, GetObjectScale() * modelInfo->combat_reach);
+        UpdateGridIndex();
 
         SetBaseWalkSpeed(modelInfo->SpeedWalk);
         SetModelRunSpeed(modelInfo->SpeedRun);
@@ -11354,13 +11400,13 @@ void Unit::StopAttackFaction(uint32 faction_id)
 
 void Unit::CleanupDeletedAuras()
 {
-    for (SpellAuraHolderList::const_iterator iter = m_deletedHolders.begin(); iter != m_deletedHolders.end(); ++iter)
-        delete *iter;
+    for (SpellAuraHolder* holder : m_deletedHolders)
+        delete holder;
     m_deletedHolders.clear();
 
     // really delete auras "deleted" while processing its ApplyModify code
-    for (AuraList::const_iterator itr = m_deletedAuras.begin(); itr != m_deletedAuras.end(); ++itr)
-        delete *itr;
+    for (Aura* aura : m_deletedAuras)
+        delete aura;
     m_deletedAuras.clear();
 }
 
@@ -11520,7 +11566,7 @@ void Unit::OnRelocated()
         m_last_notified_position.y = GetPositionY();
         m_last_notified_position.z = GetPositionZ();
 
-        GetViewPoint().Call_UpdateVisibilityForOwner();
+        GetViewPoint().Event_Relocated();
         UpdateObjectVisibility();
     }
     ScheduleAINotify(World::GetRelocationAINotifyDelay());
@@ -12354,13 +12400,27 @@ void Unit::UpdateAllowedPositionZ(float x, float y, float& z, Map* atMap /*=null
     if (!atMap)
         atMap = GetMap();
 
+    float groundZ = CanFly() ? atMap->GetHeight(x, y, z) : GetMap()->GetHeight(x, y, z, CanSwim());
+    ClampToAllowedPositionZ(x, y, z, groundZ, atMap);
+}
+
+void Unit::UpdateAllowedPositionsZ(uint32 count, float const* x, float const* y, float* z) const
+{
+    std::vector<float> groundZ(count);
+    GetMap()->GetHeights(count, x, y, z, groundZ.data(), !CanFly() && CanSwim());
+
+    for (uint32 i = 0; i < count; ++i)
+        ClampToAllowedPositionZ(x[i], y[i], z[i], groundZ[i], GetMap());
+}
+
+void Unit::ClampToAllowedPositionZ(float x, float y, float& z, float groundZ, Map* atMap) const
+{
     // non fly unit don't must be in air
     // non swim unit must be at ground (mostly speedup, because it don't must be in water and water level check less fast
     if (!CanFly())
     {
-        bool canSwim = CanSwim();
-        float groundZ = GetMap()->GetHeight(x, y, z, canSwim), maxZ;
-        if (canSwim)
+        float maxZ;
+        if (CanSwim())
             maxZ = atMap->GetTerrain()->GetWaterOrGroundLevel(x, y, z, groundZ, !HasAuraType(SPELL_AURA_WATER_WALK), GetCollisionHeight());
         else
             maxZ = groundZ;
@@ -12374,7 +12434,6 @@ void Unit::UpdateAllowedPositionZ(float x, float y, float& z, Map* atMap /*=null
     }
     else
     {
-        float groundZ = atMap->GetHeight(x, y, z);
         if (z < groundZ)
             z = groundZ;
     }
@@ -45,6 +45,7 @@
 #include "Util/Timer.h"
 #include "AI/BaseAI/UnitAI.h"
 #include "Spells/SpellDefines.h"
+#include "Spells/SpellAuraProcIndex.h"
 #include "Maps/SpawnGroupDefines.h"
 
 #include <list>
@@ -2173,6 +2174,9 @@ class Unit : public WorldObject
 
         int32 GetTotalAuraModifier(AuraType auratype) const;
         float GetTotalAuraMultiplier(AuraType auratype) const;
+        // drop cached totals of the aura type, needed after changing an amount of an applied aura outside its handler
+        void InvalidateAuraAggregate(AuraType auratype);
+        void InvalidateAuraAggregates() { m_auraAggregates.clear(); }
         int32 GetMaxPositiveAuraModifier(AuraType auratype) const;
         int32 GetMaxNegativeAuraModifier(AuraType auratype) const;
 
@@ -2481,6 +2485,8 @@ class Unit : public WorldObject
 
         // WorldObject overrides
         void UpdateAllowedPositionZ(float x, float y, float& z, Map* atMap = nullptr) const override;
+        // UpdateAllowedPositionZ of count points on the own map, ground heights are looked up in one batch
+        void UpdateAllowedPositionsZ(uint32 count, float const* x, float const* y, float* z) const;
         void AdjustZForCollision(float x, float y, float& z, float halfHeight) const override;
 
         virtual uint32 GetSpellRank(SpellEntry const* spellInfo) const;
@@ -2569,8 +2575,9 @@ class Unit : public WorldObject
 
         SpellAuraHolderMap m_spellAuraHolders;
         SpellAuraHolderMap::iterator m_spellAuraHoldersUpdateIterator; // != end() in Unit::m_spellAuraHolders update and point to next element
-        AuraList m_deletedAuras;                            // auras removed while in ApplyModifier and waiting deleted
-        SpellAuraHolderList m_deletedHolders;
+        SpellAuraProcIndex m_procAuraHolders;               // holders of m_spellAuraHolders able to proc, with their proc flags
+        std::vector<Aura*> m_deletedAuras;                  // auras removed while in ApplyModifier and waiting deleted
+        std::vector<SpellAuraHolder*> m_deletedHolders;
         std::map<uint32, Aura*> m_classScripts;
         std::vector<Aura*> m_scriptedLocations[SCRIPT_LOCATION_MAX];
         std::vector<Aura*> m_scalingAuras;
@@ -2589,6 +2596,16 @@ class Unit : public WorldObject
         std::map<uint32, Creature*> m_creatures;
 
         AuraList m_modAuras[TOTAL_AURAS];
+
+        // GetTotalAuraModifier and GetTotalAuraMultiplier results of longer aura lists
+        struct AuraAggregate
+        {
+            AuraType type;
+            int32 total;
+            float multiplier;
+        };
+        AuraAggregate const& GetAuraAggregate(AuraType auratype) const;
+        mutable std::vector<AuraAggregate> m_auraAggregates;
         float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
 
         enum class AttackPowerMod
@@ -2675,6 +2692,7 @@ class Unit : public WorldObject
     private:
         void CleanupDeletedAuras();
         void UpdateSplineMovement(uint32 t_diff);
+        void ClampToAllowedPositionZ(float x, float y, float& z, float groundZ, Map* atMap) const;
 
         float GetCombatRatingReduction(CombatRating cr) const;
         uint32 GetCombatRatingDamageReduction(CombatRating cr, float rate, float cap, uint32 damage) const;
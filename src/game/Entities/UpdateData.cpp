@@ -20,6 +20,7 @@
 
 #include "Common.h"
 #include "Entities/UpdateData.h"
+#include "Entities/UpdateMask.h"
 #include "Util/ByteBuffer.h"
 #include "Server/WorldPacket.h"
 #include "Log/Log.h"
@@ -37,6 +38,11 @@ void UpdateData::AddOutOfRangeGUID(GuidSet& guids)
     m_outOfRangeGUIDs.insert(guids.begin(), guids.end());
 }
 
+void UpdateData::AddOutOfRangeGUID(GuidFlatSet const& guids)
+{
+    m_outOfRangeGUIDs.insert(guids.begin(), guids.end());
+}
+
 void UpdateData::AddOutOfRangeGUID(ObjectGuid const& guid)
 {
     m_outOfRangeGUIDs.insert(guid);
@@ -60,60 +66,109 @@ void UpdateData::AddUpdateBlock(const ByteBuffer& block)
     }
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+// deflate state is ~256KB, so every thread keeps one stream per used level and only resets it between packets.
+// The level of a stream is never changed, deflateParams would flush through the buffers of the previous packet
+class UpdatePacketCompressor
 {
-    z_stream c_stream;
-
-    c_stream.zalloc = (alloc_func)nullptr;
-    c_stream.zfree = (free_func)nullptr;
-    c_stream.opaque = (voidpf)nullptr;
+    public:
+        UpdatePacketCompressor() : m_initialized(false)
+        {
+            m_stream.zalloc = (alloc_func)nullptr;
+            m_stream.zfree = (free_func)nullptr;
+            m_stream.opaque = (voidpf)nullptr;
+        }
+        ~UpdatePacketCompressor() { End(); }
+
+        z_stream* Acquire(int level)
+        {
+            int z_res;
+            if (!m_initialized)
+            {
+                z_res = deflateInit(&m_stream, level);
+                if (z_res != Z_OK)
+                {
+                    sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                    return nullptr;
+                }
+                m_initialized = true;
+                return &m_stream;
+            }
+
+            z_res = deflateReset(&m_stream);
+            if (z_res != Z_OK)
+            {
+                sLog.outError("Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
+                End();
+                return nullptr;
+            }
+            return &m_stream;
+        }
+
+        // drops the stream after a failure, next Acquire starts from a fresh one
+        void End()
+        {
+            if (!m_initialized)
+                return;
+
+            deflateEnd(&m_stream);
+            m_initialized = false;
+        }
+
+    private:
+        z_stream m_stream;
+        bool m_initialized;
+};
+
+static thread_local UpdatePacketCompressor t_compressors[Z_BEST_COMPRESSION + 1];
 
+void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+{
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
-    if (z_res != Z_OK)
+    int level = sWorld.getConfig(CONFIG_UINT32_COMPRESSION);
+    if (uint32 largeLevel = sWorld.getConfig(CONFIG_UINT32_COMPRESSION_LARGE))
+        if (uint32(src_size) >= sWorld.getConfig(CONFIG_UINT32_COMPRESSION_LARGE_SIZE))
+            level = largeLevel;
+
+    UpdatePacketCompressor& compressor = t_compressors[level];
+    z_stream* c_stream = compressor.Acquire(level);
+    if (!c_stream)
     {
-        sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
+    c_stream->next_in = (Bytef*)src;
+    c_stream->avail_in = (uInt)src_size;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
+    int z_res = deflate(c_stream, Z_NO_FLUSH);
     if (z_res != Z_OK)
     {
         sLog.outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
+        compressor.End();
         *dst_size = 0;
         return;
     }
 
-    if (c_stream.avail_in != 0)
+    if (c_stream->avail_in != 0)
     {
         sLog.outError("Can't compress update packet (zlib: deflate not greedy)");
+        compressor.End();
         *dst_size = 0;
         return;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         sLog.outError("Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
+        compressor.End();
         *dst_size = 0;
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    *dst_size = c_stream.total_out;
+    *dst_size = c_stream->total_out;
 }
 
 WorldPacket UpdateData::BuildPacket(size_t index, bool hasTransport)
@@ -175,3 +230,22 @@ void UpdateData::SendData(WorldSession& session)
         session.SendPacket(packet);
     }
 }
+
+ByteBuffer const* UpdateBlockCache::Find(UpdateMask const& updateMask, std::vector<uint32> const& viewerValues) const
+{
+    // few distinct masks per object (public, party, owner), linear search is enough
+    for (Entry const& entry : m_entries)
+    {
+        if (entry.mask.size() != updateMask.GetLength() || entry.viewerValues != viewerValues)
+            continue;
+
+        if (std::memcmp(entry.mask.data(), updateMask.GetMask(), entry.mask.size()) == 0)
+            return &entry.block;
+    }
+    return nullptr;
+}
+
+void UpdateBlockCache::Add(UpdateMask const& updateMask, std::vector<uint32>&& viewerValues, ByteBuffer&& block)
+{
+    m_entries.push_back({ std::vector<uint8>(updateMask.GetMask(), updateMask.GetMask() + updateMask.GetLength()), std::move(viewerValues), std::move(block) });
+}
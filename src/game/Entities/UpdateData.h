@@ -21,9 +21,11 @@
 
 #include "Util/ByteBuffer.h"
 #include "Entities/ObjectGuid.h"
+#include "Entities/GuidFlatSet.h"
 
 class WorldPacket;
 class WorldSession;
+class UpdateMask;
 
 enum ObjectUpdateType
 {
@@ -59,6 +61,7 @@ class UpdateData
         UpdateData();
 
         void AddOutOfRangeGUID(GuidSet& guids);
+        void AddOutOfRangeGUID(GuidFlatSet const& guids);
         void AddOutOfRangeGUID(ObjectGuid const& guid);
         void AddUpdateBlock(const ByteBuffer& block);
         WorldPacket BuildPacket(size_t index, bool hasTransport = false); // Copy Elision is a thing
@@ -77,4 +80,26 @@ class UpdateData
 
         static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
 };
+
+/**
+ * Values update blocks of one object built during one client update pass.
+ * Viewers receiving the same fields with the same values for the viewer dependent
+ * fields get the already serialized block instead of building it again.
+ */
+class UpdateBlockCache
+{
+    public:
+        ByteBuffer const* Find(UpdateMask const& updateMask, std::vector<uint32> const& viewerValues) const;
+        void Add(UpdateMask const& updateMask, std::vector<uint32>&& viewerValues, ByteBuffer&& block);
+
+    private:
+        struct Entry
+        {
+            std::vector<uint8> mask;
+            std::vector<uint32> viewerValues;
+            ByteBuffer block;
+        };
+
+        std::vector<Entry> m_entries;
+};
 #endif
@@ -26,6 +26,7 @@
 #include "Globals/ObjectAccessor.h"
 #include "BattleGround/BattleGroundMgr.h"
 #include "AI/BaseAI/UnitAI.h"
+#include "World/World.h"
 
 using namespace MaNGOS;
 
@@ -38,6 +39,35 @@ void VisibleChangesNotifier::Visit(CameraMapType& m)
     }
 }
 
+VisibleNotifier::VisibleNotifier(Camera& c, bool relocated) : i_camera(c), i_clientGUIDs(c.GetOwner()->GetClientGuids()), i_keptRangeSq(0.0f)
+{
+    // ghosts see around their corpse, so their view does not depend on own position only
+    if (relocated && sWorld.getConfig(CONFIG_BOOL_VISIBILITY_INCREMENTAL) && c.GetOwner()->IsAlive())
+    {
+        float range = c.GetBody()->GetMap()->GetVisibilityDistance();
+        i_keptRangeSq = range * range;
+    }
+}
+
+bool VisibleNotifier::IsKeptInRange(WorldObject const* target) const
+{
+    if (!i_keptRangeSq)
+        return false;
+
+    // other state changes of a visible object update its visibility by itself, only the distance to the moved
+    // viewpoint is to check. Overridden visibility distances and stealthed traps depend on distance in other ways
+    if (target->GetVisibilityData().IsVisibilityOverridden())
+        return false;
+
+    if (target->GetTypeId() == TYPEID_GAMEOBJECT && static_cast<GameObject const*>(target)->GetGoType() == GAMEOBJECT_TYPE_TRAP)
+        return false;
+
+    WorldObject const* viewPoint = i_camera.GetBody();
+    float dx = target->GetPositionX() - viewPoint->GetPositionX();
+    float dy = target->GetPositionY() - viewPoint->GetPositionY();
+    return dx * dx + dy * dy < i_keptRangeSq;
+}
+
 void VisibleNotifier::Notify()
 {
     Player& player = *i_camera.GetOwner();
@@ -64,22 +94,22 @@ void VisibleNotifier::Notify()
     }
 
     // Far objects update on player notify
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
+    for (GuidFlatSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end();)
     {
-        GuidSet::iterator current = itr++;
-        if (WorldObject* obj = player.GetMap()->GetWorldObject(*current))
+        WorldObject* obj = player.GetMap()->GetWorldObject(*itr);
+        if (!obj || !obj->GetVisibilityData().IsVisibilityOverridden())
         {
-            if (!obj->GetVisibilityData().IsVisibilityOverridden())
-                continue;
-
-            player.UpdateVisibilityOf(&player, obj);
-            i_clientGUIDs.erase(current);
+            ++itr;
+            continue;
         }
+
+        player.UpdateVisibilityOf(&player, obj);
+        itr = i_clientGUIDs.erase(itr);
     }
 
     // generate outOfRange for not iterate objects
     i_data.AddOutOfRangeGUID(i_clientGUIDs);
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
+    for (GuidFlatSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
     {
         if (WorldObject* target = player.GetMap()->GetWorldObject(*itr))
         {
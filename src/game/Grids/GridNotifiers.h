@@ -37,13 +37,18 @@ namespace MaNGOS
     {
         Camera& i_camera;
         UpdateData i_data;
-        GuidSet i_clientGUIDs;
+        GuidFlatSet i_clientGUIDs;
         WorldObjectSet i_visibleNow;
+        float i_keptRangeSq;                                // 0 when every visited object is rechecked
 
-        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->GetClientGuids()) {}
+        // relocated: update after a move of the viewpoint, objects at client that stay in range are not rechecked
+        explicit VisibleNotifier(Camera& c, bool relocated = false);
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(CameraMapType& /*m*/) {}
         void Notify(void);
+
+        private:
+            bool IsKeptInRange(WorldObject const* target) const;
     };
 
     struct VisibleChangesNotifier
@@ -330,6 +335,28 @@ namespace MaNGOS
 
     // Unit searchers
 
+    // Checks accepting no unit farther than GetPrefilterRange() plus the unit's reach (2D) from
+    // GetFocusObject(). Unit searchers skip the other units of a cell by its packed position index.
+    template<class Check>
+    concept PrefilteredCheck = requires(Check const& check) { check.GetPrefilterRange(); check.GetFocusObject(); };
+
+    // Calls visit for the objects of the list that may pass the check, in list order, until visit returns false
+    template<class Check, class T, class Visit>
+    inline void VisitCandidates(Check const& check, GridRefManager<T>& m, Visit&& visit)
+    {
+        if constexpr (PrefilteredCheck<Check>)
+        {
+            WorldObject const& focus = check.GetFocusObject();
+            m.GetIndex().VisitInRange(focus.GetPositionX(), focus.GetPositionY(), check.GetPrefilterRange(), visit);
+        }
+        else
+        {
+            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+                if (!visit(itr->getSource()))
+                    return;
+        }
+    }
+
     // First accepted by Check Unit if any
     template<class Check>
     struct UnitSearcher
@@ -989,6 +1016,7 @@ namespace MaNGOS
                 i_controlledByPlayer = obj->IsControlledByPlayer();
             }
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetPrefilterRange() const { return i_range + i_obj->GetCombatReach(); }
             bool operator()(Unit* u) const
             {
                 // ignore totems
@@ -1009,6 +1037,7 @@ namespace MaNGOS
             AnySpellAssistableUnitInObjectRangeCheck(WorldObject const* obj, SpellEntry const* spellInfo, float range, bool ignorePhase = false)
                 : i_obj(obj), i_spellInfo(spellInfo), i_range(range), i_ignorePhase(ignorePhase) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetPrefilterRange() const { return i_range + i_obj->GetCombatReach(); }
             bool operator()(Unit* u)
             {
                 return u->IsAlive() && i_obj->IsWithinDistInMap(u, i_range, true, i_ignorePhase) && i_obj->CanAssistSpell(u, i_spellInfo);
@@ -1026,6 +1055,7 @@ namespace MaNGOS
             AnyFriendlyUnitInObjectRangeCheck(WorldObject const* obj, float range, bool ignorePhase = false)
                 : i_obj(obj), i_range(range), i_ignorePhase(ignorePhase) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetPrefilterRange() const { return i_range + i_obj->GetCombatReach(); }
             bool operator()(Unit* u)
             {
                 return u->IsAlive() && i_obj->IsWithinDistInMap(u, i_range, true, i_ignorePhase) && i_obj->CanAssistSpell(u);
@@ -1103,6 +1133,7 @@ namespace MaNGOS
         public:
             AnyUnitInObjectRangeCheck(WorldObject const* obj, float range) : i_obj(obj), i_range(range) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetPrefilterRange() const { return i_range + i_obj->GetCombatReach(); }
             bool operator()(Unit* u)
             {
                 return u->IsAlive() && i_obj->IsWithinDistInMap(u, i_range);
@@ -1137,6 +1168,7 @@ namespace MaNGOS
             NearestAttackableUnitInObjectRangeCheck(NearestAttackableUnitInObjectRangeCheck const&) =  delete;
 
             Unit const& GetFocusObject() const { return *m_source; }
+            float GetPrefilterRange() const { return m_range + m_source->GetCombatReach(); }
 
             bool operator()(Unit* currUnit)
             {
@@ -1167,6 +1199,7 @@ namespace MaNGOS
                 i_targetForPlayer = i_obj->IsControlledByPlayer();
             }
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetPrefilterRange() const { return i_range + i_obj->GetCombatReach(); }
             bool operator()(Unit* u)
             {
                 // Check contains checks for: live, non-selectable, non-attackable flags, flight check and GM check, ignore totems
@@ -1344,6 +1377,7 @@ namespace MaNGOS
         public:
             AllCreaturesOfEntryInRangeCheck(const WorldObject* pObject, uint32 uiEntry, float fMaxRange) : m_pObject(pObject), m_uiEntry(uiEntry), m_fRange(fMaxRange) {}
             WorldObject const& GetFocusObject() const { return *m_pObject; }
+            float GetPrefilterRange() const { return m_fRange + m_pObject->GetCombatReach(); }
             bool operator()(Unit* pUnit)
             {
                 return pUnit->GetEntry() == m_uiEntry && m_pObject->IsWithinDist(pUnit, m_fRange, false);
@@ -1386,6 +1420,7 @@ namespace MaNGOS
         public:
             AnyPlayerInObjectRangeCheck(WorldObject const* obj, float range) : i_obj(obj), i_range(range) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetPrefilterRange() const { return i_range + i_obj->GetCombatReach(); }
             bool operator()(Player* u)
             {
                 return u->IsAlive() && i_obj->IsWithinDistInMap(u, i_range);
@@ -1401,6 +1436,7 @@ namespace MaNGOS
             AnyPlayerInObjectRangeWithAuraCheck(WorldObject const* obj, float range, uint32 spellId)
                 : i_obj(obj), i_range(range), i_spellId(spellId) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetPrefilterRange() const { return i_range + i_obj->GetCombatReach(); }
             bool operator()(Player* u)
             {
                 return u->IsAlive()
@@ -35,8 +35,11 @@ inline void MaNGOS::VisibleNotifier::Visit(GridRefManager<T>& m)
 {
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
-        i_clientGUIDs.erase(iter->getSource()->GetObjectGuid());
+        T* target = iter->getSource();
+        if (i_clientGUIDs.erase(target->GetObjectGuid()) && IsKeptInRange(target))
+            continue;
+
+        i_camera.UpdateVisibilityOf(target, i_data, i_visibleNow);
     }
 }
 
@@ -514,14 +517,14 @@ void MaNGOS::UnitSearcher<Check>::Visit(CreatureMapType& m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(i_check, m, [&](Creature* creature)
     {
-        if (i_check(itr->getSource()))
-        {
-            i_object = itr->getSource();
-            return;
-        }
-    }
+        if (!i_check(creature))
+            return true;
+
+        i_object = creature;
+        return false;
+    });
 }
 
 template<class Check>
@@ -531,50 +534,58 @@ void MaNGOS::UnitSearcher<Check>::Visit(PlayerMapType& m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(i_check, m, [&](Player* player)
     {
-        if (i_check(itr->getSource()))
-        {
-            i_object = itr->getSource();
-            return;
-        }
-    }
+        if (!i_check(player))
+            return true;
+
+        i_object = player;
+        return false;
+    });
 }
 
 template<class Check>
 void MaNGOS::UnitLastSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(i_check, m, [&](Creature* creature)
     {
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+        if (i_check(creature))
+            i_object = creature;
+        return true;
+    });
 }
 
 template<class Check>
 void MaNGOS::UnitLastSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(i_check, m, [&](Player* player)
     {
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+        if (i_check(player))
+            i_object = player;
+        return true;
+    });
 }
 
 template<class Check>
 void MaNGOS::UnitListSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->getSource()))
-            i_objects.push_back(itr->getSource());
+    VisitCandidates(i_check, m, [&](Player* player)
+    {
+        if (i_check(player))
+            i_objects.push_back(player);
+        return true;
+    });
 }
 
 template<class Check>
 void MaNGOS::UnitListSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->getSource()))
-            i_objects.push_back(itr->getSource());
+    VisitCandidates(i_check, m, [&](Creature* creature)
+    {
+        if (i_check(creature))
+            i_objects.push_back(creature);
+        return true;
+    });
 }
 
 // Creature searchers
@@ -586,32 +597,36 @@ void MaNGOS::CreatureSearcher<Check>::Visit(CreatureMapType& m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(i_check, m, [&](Creature* creature)
     {
-        if (i_check(itr->getSource()))
-        {
-            i_object = itr->getSource();
-            return;
-        }
-    }
+        if (!i_check(creature))
+            return true;
+
+        i_object = creature;
+        return false;
+    });
 }
 
 template<class Check>
 void MaNGOS::CreatureLastSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(i_check, m, [&](Creature* creature)
     {
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+        if (i_check(creature))
+            i_object = creature;
+        return true;
+    });
 }
 
 template<class Check>
 void MaNGOS::CreatureListSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->getSource()))
-            i_objects.push_back(itr->getSource());
+    VisitCandidates(i_check, m, [&](Creature* creature)
+    {
+        if (i_check(creature))
+            i_objects.push_back(creature);
+        return true;
+    });
 }
 
 template<class Check>
@@ -621,22 +636,25 @@ void MaNGOS::PlayerSearcher<Check>::Visit(PlayerMapType& m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitCandidates(i_check, m, [&](Player* player)
     {
-        if (i_check(itr->getSource()))
-        {
-            i_object = itr->getSource();
-            return;
-        }
-    }
+        if (!i_check(player))
+            return true;
+
+        i_object = player;
+        return false;
+    });
 }
 
 template<class Check>
 void MaNGOS::PlayerListSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->getSource()))
-            i_objects.push_back(itr->getSource());
+    VisitCandidates(i_check, m, [&](Player* player)
+    {
+        if (i_check(player))
+            i_objects.push_back(player);
+        return true;
+    });
 }
 
 template<class Builder>
@@ -29,7 +29,24 @@
 #include "Policies/Singleton.h"
 #include "Util/Util.h"
 
+#include <algorithm>
 #include <mutex>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define GRIDMAP_HEIGHT_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GRIDMAP_HEIGHT_SSE2
+#endif
+
+#if PLATFORM != PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 char const* MAP_MAGIC         = "MAPS";
 char const* MAP_VERSION_MAGIC = "s1.4";
@@ -67,6 +84,10 @@ GridMap::GridMap(): m_gridIntHeightMultiplier(0)
     m_liquidEntry = nullptr;
     m_liquid_map  = nullptr;
     m_fullyLoaded = false;
+
+    m_fileData = nullptr;
+    m_fileSize = 0;
+    m_fileMapped = false;
 }
 
 GridMap::~GridMap()
@@ -74,74 +95,137 @@ GridMap::~GridMap()
     unloadData();
 }
 
-bool GridMap::loadData(char const* filename)
+bool GridMap::loadData(char const* filename, bool mapped /*= false*/)
 {
     // Unload old data if exist
     unloadData();
 
-    GridMapFileHeader header;
-    // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    if (!(mapped && mapFile(filename)) && !readFile(filename))
     {
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Failled to found %s", filename);
         // its a valid error only in case of no vmap files are available too
         return true;
     }
 
-    fread(&header, sizeof(header), 1, in);
-    if (header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
+    GridMapFileHeader header;
+    if (m_fileSize >= sizeof(header))
+        memcpy(&header, m_fileData, sizeof(header));
+
+    if (m_fileSize >= sizeof(header) &&
+            header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
             header.versionMagic == *((uint32 const*)(MAP_VERSION_MAGIC)))
     {
         // loadup area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header.areaMapOffset && !loadAreaData(header.areaMapOffset, header.areaMapSize))
         {
             sLog.outError("Error loading map area data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup holes data
-        if (header.holesOffset && !loadHolesData(in, header.holesOffset, header.holesSize))
+        if (header.holesOffset && !loadHolesData(header.holesOffset, header.holesSize))
         {
             sLog.outError("Error loading map holes data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+        if (header.heightMapOffset && !loadHeightData(header.heightMapOffset, header.heightMapSize))
         {
             sLog.outError("Error loading map height data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup liquid data
-        if (header.liquidMapOffset && !loadGridMapLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header.liquidMapOffset && !loadGridMapLiquidData(header.liquidMapOffset, header.liquidMapSize))
         {
             sLog.outError("Error loading map liquids data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
-        fclose(in);
         return true;
     }
 
     sLog.outError("Map file '%s' is non-compatible version (outdated?). Please, create new using ad.exe program.", filename);
-    fclose(in);
+    unloadData();
+    return false;
+}
+
+bool GridMap::mapFile(char const* filename)
+{
+#if PLATFORM != PLATFORM_WINDOWS
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    // read only mapping, the pages come from the page cache and are shared by every process and every reload
+    void* base = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        return false;
+
+    m_fileData = static_cast<uint8*>(base);
+    m_fileSize = fileStat.st_size;
+    m_fileMapped = true;
+    return true;
+#else
     return false;
+#endif
+}
+
+bool GridMap::readFile(char const* filename)
+{
+    FILE* in = fopen(filename, "rb");
+    if (!in)
+        return false;
+
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+
+    // the whole file is read at once, the data arrays point into it just like into a mapping
+    uint8* data = size > 0 ? new uint8[size] : nullptr;
+    if (!data || fread(data, size, 1, in) != 1)
+    {
+        delete[] data;
+        fclose(in);
+        return false;
+    }
+
+    fclose(in);
+
+    m_fileData = data;
+    m_fileSize = size;
+    m_fileMapped = false;
+    return true;
 }
 
 void GridMap::unloadData()
 {
-    delete[] m_area_map;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] m_liquidEntry;
-    delete[] m_liquidFlags;
-    delete[] m_liquid_map;
+    if (m_fileMapped)
+    {
+#if PLATFORM != PLATFORM_WINDOWS
+        munmap(m_fileData, m_fileSize);
+#endif
+    }
+    else
+        delete[] m_fileData;
+
+    m_fileData = nullptr;
+    m_fileSize = 0;
+    m_fileMapped = false;
+    m_alignedCopies.clear();
 
     m_area_map = nullptr;
     m_V9 = nullptr;
@@ -152,61 +236,82 @@ void GridMap::unloadData()
     m_gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+template<typename T>
+T const* GridMap::getFileArray(uint32 offset, uint32 count)
+{
+    if (size_t(offset) + size_t(count) * sizeof(T) > m_fileSize)
+        return nullptr;
+
+    uint8 const* data = m_fileData + offset;
+    if (reinterpret_cast<uintptr_t>(data) % alignof(T) == 0)
+        return reinterpret_cast<T const*>(data);
+
+    // the extractor does not pad sections, the liquid data following 8 bit heights ends up unaligned
+    m_alignedCopies.emplace_back(new uint8[size_t(count) * sizeof(T)]);
+    memcpy(m_alignedCopies.back().get(), data, size_t(count) * sizeof(T));
+    return reinterpret_cast<T const*>(m_alignedCopies.back().get());
+}
+
+template<typename T>
+bool GridMap::readFileHeader(uint32 offset, T& header) const
+{
+    if (size_t(offset) + sizeof(T) > m_fileSize)
+        return false;
+
+    memcpy(&header, m_fileData + offset, sizeof(T));
+    return true;
+}
+
+bool GridMap::loadAreaData(uint32 offset, uint32 /*size*/)
 {
     GridMapAreaHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
+    if (!readFileHeader(offset, header) || header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
         return false;
 
     m_gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        m_area_map = new uint16 [16 * 16];
-        fread(m_area_map, sizeof(uint16), 16 * 16, in);
+        m_area_map = getFileArray<uint16>(offset + sizeof(header), 16 * 16);
+        if (!m_area_map)
+            return false;
     }
 
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(uint32 offset, uint32 /*size*/)
 {
     GridMapHeightHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
+    if (!readFileHeader(offset, header) || header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
         return false;
 
+    offset += sizeof(header);
     m_gridHeight = header.gridHeight;
     if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129 * 129];
-            m_uint16_V8 = new uint16 [128 * 128];
-            fread(m_uint16_V9, sizeof(uint16), 129 * 129, in);
-            fread(m_uint16_V8, sizeof(uint16), 128 * 128, in);
+            m_uint16_V9 = getFileArray<uint16>(offset, 129 * 129);
+            m_uint16_V8 = getFileArray<uint16>(offset + 129 * 129 * sizeof(uint16), 128 * 128);
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129 * 129];
-            m_uint8_V8 = new uint8 [128 * 128];
-            fread(m_uint8_V9, sizeof(uint8), 129 * 129, in);
-            fread(m_uint8_V8, sizeof(uint8), 128 * 128, in);
+            m_uint8_V9 = getFileArray<uint8>(offset, 129 * 129);
+            m_uint8_V8 = getFileArray<uint8>(offset + 129 * 129 * sizeof(uint8), 128 * 128);
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129 * 129];
-            m_V8 = new float [128 * 128];
-            fread(m_V9, sizeof(float), 129 * 129, in);
-            fread(m_V8, sizeof(float), 128 * 128, in);
+            m_V9 = getFileArray<float>(offset, 129 * 129);
+            m_V8 = getFileArray<float>(offset + 129 * 129 * sizeof(float), 128 * 128);
             m_gridGetHeight = &GridMap::getHeightFromFloat;
         }
+
+        if (!m_V9 || !m_V8)
+            return false;
     }
     else
         m_gridGetHeight = &GridMap::getHeightFromFlat;
@@ -214,24 +319,18 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHolesData(uint32 offset, uint32 /*size*/)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
-        return false;
-
-    if (fread(&m_holes, sizeof(m_holes), 1, in) != 1)
-        return false;
-    return true;
+    return readFileHeader(offset, m_holes);
 }
 
-bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadGridMapLiquidData(uint32 offset, uint32 /*size*/)
 {
     GridMapLiquidHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
+    if (!readFileHeader(offset, header) || header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
         return false;
 
+    offset += sizeof(header);
     m_liquidGlobalEntry = header.liquidType;
     m_liquidGlobalFlags = header.liquidFlags;
     m_liquid_offX   = header.offsetX;
@@ -242,17 +341,21 @@ bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquidEntry = new uint16[16 * 16];
-        fread(m_liquidEntry, sizeof(uint16), 16 * 16, in);
+        m_liquidEntry = getFileArray<uint16>(offset, 16 * 16);
+        offset += 16 * 16 * sizeof(uint16);
 
-        m_liquidFlags = new uint8[16 * 16];
-        fread(m_liquidFlags, sizeof(uint8), 16 * 16, in);
+        m_liquidFlags = getFileArray<uint8>(offset, 16 * 16);
+        offset += 16 * 16 * sizeof(uint8);
+
+        if (!m_liquidEntry || !m_liquidFlags)
+            return false;
     }
 
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquid_map = new float [m_liquid_width * m_liquid_height];
-        fread(m_liquid_map, sizeof(float), m_liquid_width * m_liquid_height, in);
+        m_liquid_map = getFileArray<float>(offset, m_liquid_width * m_liquid_height);
+        if (!m_liquid_map)
+            return false;
     }
 
     return true;
@@ -388,7 +491,7 @@ float GridMap::getHeightFromUint8(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint8* V9_h1_ptr = &m_uint8_V9[x_int * 128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &m_uint8_V9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -456,7 +559,7 @@ float GridMap::getHeightFromUint16(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint16* V9_h1_ptr = &m_uint16_V9[x_int * 128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &m_uint16_V9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -508,6 +611,188 @@ float GridMap::getHeightFromUint16(float x, float y) const
     return (float)((a * x) + (b * y) + c) * m_gridIntHeightMultiplier + m_gridHeight;
 }
 
+namespace
+{
+    uint32 const HEIGHT_BATCH_SIZE = 64;
+
+    // corner heights of the cell under each point of a batch, h5 already doubled, and the position inside the cell
+    struct HeightCorners
+    {
+        alignas(32) float h1[HEIGHT_BATCH_SIZE];
+        alignas(32) float h2[HEIGHT_BATCH_SIZE];
+        alignas(32) float h3[HEIGHT_BATCH_SIZE];
+        alignas(32) float h4[HEIGHT_BATCH_SIZE];
+        alignas(32) float h5[HEIGHT_BATCH_SIZE];
+        alignas(32) float x[HEIGHT_BATCH_SIZE];
+        alignas(32) float y[HEIGHT_BATCH_SIZE];
+    };
+
+    // triangle selection and h = a*x + b*y + c of getHeightFrom*, kept in the same operation order
+    inline float InterpolateHeight(float h1, float h2, float h3, float h4, float h5, float x, float y)
+    {
+        float a, b, c;
+        if (x + y < 1)
+        {
+            if (x > y)
+            {
+                a = h2 - h1;
+                b = h5 - h1 - h2;
+                c = h1;
+            }
+            else
+            {
+                a = h5 - h1 - h3;
+                b = h3 - h1;
+                c = h1;
+            }
+        }
+        else
+        {
+            if (x > y)
+            {
+                a = h2 + h4 - h5;
+                b = h4 - h2;
+                c = h5 - h4;
+            }
+            else
+            {
+                a = h4 - h3;
+                b = h3 + h4 - h5;
+                c = h5 - h4;
+            }
+        }
+        return a * x + b * y + c;
+    }
+
+#if defined(GRIDMAP_HEIGHT_AVX2)
+    typedef __m256 HeightVector;
+    uint32 const HEIGHT_VECTOR_WIDTH = 8;
+    inline HeightVector VectorLoad(float const* p) { return _mm256_load_ps(p); }
+    inline void VectorStore(float* p, HeightVector v) { _mm256_storeu_ps(p, v); }
+    inline HeightVector VectorSet(float v) { return _mm256_set1_ps(v); }
+    inline HeightVector VectorAdd(HeightVector a, HeightVector b) { return _mm256_add_ps(a, b); }
+    inline HeightVector VectorSub(HeightVector a, HeightVector b) { return _mm256_sub_ps(a, b); }
+    inline HeightVector VectorMul(HeightVector a, HeightVector b) { return _mm256_mul_ps(a, b); }
+    inline HeightVector VectorLess(HeightVector a, HeightVector b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    inline HeightVector VectorGreater(HeightVector a, HeightVector b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    inline HeightVector VectorSelect(HeightVector mask, HeightVector ifSet, HeightVector ifNotSet) { return _mm256_blendv_ps(ifNotSet, ifSet, mask); }
+#elif defined(GRIDMAP_HEIGHT_SSE2)
+    typedef __m128 HeightVector;
+    uint32 const HEIGHT_VECTOR_WIDTH = 4;
+    inline HeightVector VectorLoad(float const* p) { return _mm_load_ps(p); }
+    inline void VectorStore(float* p, HeightVector v) { _mm_storeu_ps(p, v); }
+    inline HeightVector VectorSet(float v) { return _mm_set1_ps(v); }
+    inline HeightVector VectorAdd(HeightVector a, HeightVector b) { return _mm_add_ps(a, b); }
+    inline HeightVector VectorSub(HeightVector a, HeightVector b) { return _mm_sub_ps(a, b); }
+    inline HeightVector VectorMul(HeightVector a, HeightVector b) { return _mm_mul_ps(a, b); }
+    inline HeightVector VectorLess(HeightVector a, HeightVector b) { return _mm_cmplt_ps(a, b); }
+    inline HeightVector VectorGreater(HeightVector a, HeightVector b) { return _mm_cmpgt_ps(a, b); }
+    inline HeightVector VectorSelect(HeightVector mask, HeightVector ifSet, HeightVector ifNotSet) { return _mm_or_ps(_mm_and_ps(mask, ifSet), _mm_andnot_ps(mask, ifNotSet)); }
+#endif
+
+    // heights[i] = InterpolateHeight(...) * scale + base
+    void InterpolateHeights(HeightCorners const& corners, float scale, float base, float* heights, uint32 count)
+    {
+        uint32 i = 0;
+#if defined(GRIDMAP_HEIGHT_AVX2) || defined(GRIDMAP_HEIGHT_SSE2)
+        HeightVector const one = VectorSet(1.0f);
+        HeightVector const vScale = VectorSet(scale);
+        HeightVector const vBase = VectorSet(base);
+        for (; i + HEIGHT_VECTOR_WIDTH <= count; i += HEIGHT_VECTOR_WIDTH)
+        {
+            HeightVector h1 = VectorLoad(&corners.h1[i]);
+            HeightVector h2 = VectorLoad(&corners.h2[i]);
+            HeightVector h3 = VectorLoad(&corners.h3[i]);
+            HeightVector h4 = VectorLoad(&corners.h4[i]);
+            HeightVector h5 = VectorLoad(&corners.h5[i]);
+            HeightVector x = VectorLoad(&corners.x[i]);
+            HeightVector y = VectorLoad(&corners.y[i]);
+
+            // every triangle is solved, the one containing the point is picked per lane
+            HeightVector upper = VectorLess(VectorAdd(x, y), one);
+            HeightVector right = VectorGreater(x, y);
+
+            HeightVector a = VectorSelect(upper,
+                                          VectorSelect(right, VectorSub(h2, h1), VectorSub(VectorSub(h5, h1), h3)),
+                                          VectorSelect(right, VectorSub(VectorAdd(h2, h4), h5), VectorSub(h4, h3)));
+            HeightVector b = VectorSelect(upper,
+                                          VectorSelect(right, VectorSub(VectorSub(h5, h1), h2), VectorSub(h3, h1)),
+                                          VectorSelect(right, VectorSub(h4, h2), VectorSub(VectorAdd(h3, h4), h5)));
+            HeightVector c = VectorSelect(upper, h1, VectorSub(h5, h4));
+
+            HeightVector h = VectorAdd(VectorAdd(VectorMul(a, x), VectorMul(b, y)), c);
+            VectorStore(&heights[i], VectorAdd(VectorMul(h, vScale), vBase));
+        }
+#endif
+        for (; i < count; ++i)
+            heights[i] = InterpolateHeight(corners.h1[i], corners.h2[i], corners.h3[i], corners.h4[i], corners.h5[i], corners.x[i], corners.y[i]) * scale + base;
+    }
+}
+
+template<typename T>
+void GridMap::getHeightsFromData(T const* V9, T const* V8, float const* x, float const* y, float* heights, uint32 count) const
+{
+    // only float heights are stored with holes, see getHeightFromFloat
+    bool const checkHoles = std::is_same<T, float>::value;
+    float const scale = checkHoles ? 1.0f : m_gridIntHeightMultiplier;
+    float const base = checkHoles ? 0.0f : m_gridHeight;
+
+    HeightCorners corners;
+    bool holes[HEIGHT_BATCH_SIZE];
+    for (uint32 start = 0; start < count; start += HEIGHT_BATCH_SIZE)
+    {
+        uint32 size = std::min(count - start, HEIGHT_BATCH_SIZE);
+        for (uint32 i = 0; i < size; ++i)
+        {
+            float cx = MAP_RESOLUTION * (32 - x[start + i] / SIZE_OF_GRIDS);
+            float cy = MAP_RESOLUTION * (32 - y[start + i] / SIZE_OF_GRIDS);
+
+            int x_int = (int)cx;
+            int y_int = (int)cy;
+            corners.x[i] = cx - x_int;
+            corners.y[i] = cy - y_int;
+            x_int &= (MAP_RESOLUTION - 1);
+            y_int &= (MAP_RESOLUTION - 1);
+            holes[i] = checkHoles && isHole(x_int, y_int);
+
+            T const* V9_h1_ptr = &V9[x_int * 128 + x_int + y_int];
+            corners.h1[i] = float(V9_h1_ptr[0]);
+            corners.h2[i] = float(V9_h1_ptr[129]);
+            corners.h3[i] = float(V9_h1_ptr[1]);
+            corners.h4[i] = float(V9_h1_ptr[130]);
+            corners.h5[i] = 2 * float(V8[x_int * 128 + y_int]);
+        }
+
+        InterpolateHeights(corners, scale, base, &heights[start], size);
+
+        if (checkHoles)
+        {
+            for (uint32 i = 0; i < size; ++i)
+                if (holes[i])
+                    heights[start + i] = INVALID_HEIGHT_VALUE;
+        }
+    }
+}
+
+void GridMap::getHeights(float const* x, float const* y, float* heights, uint32 count) const
+{
+    if (!count)
+        return;
+
+    if (m_gridGetHeight == &GridMap::getHeightFromFloat && m_V8 && m_V9)
+        getHeightsFromData(m_V9, m_V8, x, y, heights, count);
+    else if (m_gridGetHeight == &GridMap::getHeightFromUint16 && m_uint16_V8 && m_uint16_V9)
+        getHeightsFromData(m_uint16_V9, m_uint16_V8, x, y, heights, count);
+    else if (m_gridGetHeight == &GridMap::getHeightFromUint8 && m_uint8_V8 && m_uint8_V9)
+        getHeightsFromData(m_uint8_V9, m_uint8_V8, x, y, heights, count);
+    else
+    {
+        // flat grid or missing height data, the single point functions do not depend on the position then
+        float height = getHeight(x[0], y[0]);
+        std::fill(heights, heights + count, height);
+    }
+}
+
 float GridMap::getLiquidLevel(float x, float y) const
 {
     if (!m_liquid_map)
@@ -690,7 +975,7 @@ bool GridMap::ExistVMap(uint32 mapid, int gx, int gy)
 }
 
 //////////////////////////////////////////////////////////////////////////
-TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
+TerrainInfo::TerrainInfo(uint32 mapid, TerrainPreloader& preloader) : m_mapId(mapid), m_preloader(preloader)
 {
     for (int k = 0; k < MAX_NUMBER_OF_GRIDS; ++k)
     {
@@ -699,6 +984,7 @@ TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
             m_GridMaps[i][k] = nullptr;
             m_GridRef[i][k] = 0;
             m_GridMapsLoadAttempted[i][k] = false;
+            m_GridPreload[i][k] = GRID_PRELOAD_NONE;
         }
     }
 
@@ -715,6 +1001,13 @@ TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
 
 TerrainInfo::~TerrainInfo()
 {
+    // no preload thread may work on this terrain anymore
+    m_preloader.Cancel(this);
+    for (int y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
+        for (int x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
+            if (m_GridPreload[x][y] != GRID_PRELOAD_NONE)
+                ReleasePreload(x, y);
+
     for (int k = 0; k < MAX_NUMBER_OF_GRIDS; ++k)
         for (auto& m_GridMap : m_GridMaps)
             delete m_GridMap[k];
@@ -731,9 +1024,9 @@ GridMap* TerrainInfo::Load(const uint32 x, const uint32 y, bool mapOnly /*= fals
     // reference grid as a first step
     RefGrid(x, y);
 
-    // quick check if GridMap already loaded
+    // quick check if GridMap already loaded, a preloaded one still misses its vmap and mmap tiles
     GridMap* pMap = m_GridMaps[x][y];
-    if (!pMap)
+    if (!pMap || (!mapOnly && !pMap->IsFullyLoaded()))
     {
         pMap = LoadMapAndVMap(x, y, mapOnly);
         m_GridMapsLoadAttempted[x][y] = true;
@@ -742,6 +1035,78 @@ GridMap* TerrainInfo::Load(const uint32 x, const uint32 y, bool mapOnly /*= fals
     return pMap;
 }
 
+bool TerrainInfo::Preload(const uint32 x, const uint32 y)
+{
+    MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
+    MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
+
+    if (!m_preloader.IsActive())
+        return false;
+
+    GridMap* pMap = m_GridMaps[x][y];
+    if (pMap && pMap->IsFullyLoaded())
+        return false;
+
+    // instances of the same map may ask for the same grid at the same time
+    uint8 state = GRID_PRELOAD_NONE;
+    if (!m_GridPreload[x][y].compare_exchange_strong(state, GRID_PRELOAD_QUEUED))
+        return false;
+
+    // keeps the GridMap away from CleanUpGrids until the preload is released
+    RefGrid(x, y);
+    m_preloader.Queue(this, x, y);
+    return true;
+}
+
+void TerrainInfo::PreloadGrid(const uint32 x, const uint32 y)
+{
+    // the GridMap is built without any lock, it is shared only once complete
+    if (!m_GridMaps[x][y])
+    {
+        GridMap* map = CreateGridMap(x, y);
+
+        LOCK_GUARD lock(m_mutex);
+        if (!m_GridMaps[x][y])
+            m_GridMaps[x][y] = map;
+        else
+            delete map;
+    }
+
+    // vmap and mmap tiles are inserted by the map thread, only their files are read ahead
+    std::vector<std::string> models;
+    m_vmgr->prefetchTileModels((sWorld.GetDataPath() + "vmaps").c_str(), m_mapId, x, y, models);
+    MMAP::MMapFactory::createOrGetMMapManager()->prefetchTile(sWorld.GetDataPath(), m_mapId, x, y);
+
+    if (!models.empty())
+    {
+        LOCK_GUARD lock(m_preloadMutex);
+        m_preloadedModels[x << 8 | y] = std::move(models);
+    }
+
+    m_GridPreload[x][y] = GRID_PRELOAD_DONE;
+}
+
+void TerrainInfo::ReleasePreload(const uint32 x, const uint32 y)
+{
+    std::vector<std::string> models;
+    {
+        LOCK_GUARD lock(m_preloadMutex);
+        auto itr = m_preloadedModels.find(x << 8 | y);
+        if (itr != m_preloadedModels.end())
+        {
+            models = std::move(itr->second);
+            m_preloadedModels.erase(itr);
+        }
+    }
+
+    // a tile the map never loaded is not kept any longer
+    m_vmgr->releaseTileModels(models);
+    MMAP::MMapFactory::createOrGetMMapManager()->dropPrefetchedTile(m_mapId, x, y);
+
+    UnrefGrid(x, y);
+    m_GridPreload[x][y] = GRID_PRELOAD_NONE;
+}
+
 // schedule lazy GridMap object cleanup
 void TerrainInfo::Unload(const uint32 x, const uint32 y)
 {
@@ -770,6 +1135,14 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
     {
         for (int x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
         {
+            // preloads are kept for at least one full clean up interval
+            switch (m_GridPreload[x][y])
+            {
+                case GRID_PRELOAD_DONE: m_GridPreload[x][y] = GRID_PRELOAD_EXPIRING; break;
+                case GRID_PRELOAD_EXPIRING: ReleasePreload(x, y); break;
+                default: break;
+            }
+
             const int16& iRef = m_GridRef[x][y];
             GridMap* pMap = m_GridMaps[x][y];
 
@@ -828,12 +1201,42 @@ int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
 float TerrainInfo::GetHeightStatic(float x, float y, float z, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
 {
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;            // Store Height obtained by maps
-    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
 
     // find raw .map surface under Z coordinates (or well-defined above)
     if (GridMap* gmap = const_cast<TerrainInfo*>(this)->GetGrid(x, y))
         mapHeight = gmap->getHeight(x, y);
 
+    return SelectHeightStatic(x, y, z, mapHeight, useVmaps, maxSearchDist);
+}
+
+void TerrainInfo::GetHeightsStatic(uint32 count, float const* x, float const* y, float const* z, float* heights, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
+{
+    // .map heights of consecutive points in the same grid are taken at once
+    for (uint32 start = 0; start < count;)
+    {
+        int gx = (int)(32 - x[start] / SIZE_OF_GRIDS);
+        int gy = (int)(32 - y[start] / SIZE_OF_GRIDS);
+
+        uint32 end = start + 1;
+        while (end < count && (int)(32 - x[end] / SIZE_OF_GRIDS) == gx && (int)(32 - y[end] / SIZE_OF_GRIDS) == gy)
+            ++end;
+
+        if (GridMap* gmap = const_cast<TerrainInfo*>(this)->GetGrid(x[start], y[start]))
+            gmap->getHeights(&x[start], &y[start], &heights[start], end - start);
+        else
+            std::fill(&heights[start], &heights[end], VMAP_INVALID_HEIGHT_VALUE);
+
+        start = end;
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+        heights[i] = SelectHeightStatic(x[i], y[i], z[i], heights[i], useVmaps, maxSearchDist);
+}
+
+float TerrainInfo::SelectHeightStatic(float x, float y, float z, float mapHeight, bool useVmaps, float maxSearchDist) const
+{
+    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
+
     if (useVmaps)
     {
         if (m_vmgr->isHeightCalcEnabled())
@@ -1234,6 +1637,26 @@ GridMap* TerrainInfo::GetGrid(const float x, const float y, bool loadOnlyMap /*=
     return pMap;
 }
 
+GridMap* TerrainInfo::CreateGridMap(const uint32 x, const uint32 y) const
+{
+    GridMap* map = new GridMap();
+
+    // map file name
+    int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
+    char* tmp = new char[len];
+    snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
+    DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
+
+    if (!map->loadData(tmp, sWorld.getConfig(CONFIG_BOOL_MAP_MEMORY_MAPPED)))
+    {
+        sLog.outError("Error load map file: %s", tmp);
+        //assert(false);
+    }
+
+    delete[] tmp;
+    return map;
+}
+
 GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnly /*= false*/)
 {
     if ((m_GridMaps[x][y] && mapOnly)
@@ -1247,24 +1670,7 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnl
         LOCK_GUARD lock(m_mutex);
         // double checked lock pattern
         if (!m_GridMaps[x][y])
-        {
-            GridMap* map = new GridMap();
-
-            // map file name
-            int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
-            char* tmp = new char[len];
-            snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
-
-            if (!map->loadData(tmp))
-            {
-                sLog.outError("Error load map file: %s", tmp);
-                //assert(false);
-            }
-
-            delete[] tmp;
-            m_GridMaps[x][y] = map;
-        }
+            m_GridMaps[x][y] = CreateGridMap(x, y);
     }
 
     // we'll load the rest later
@@ -1337,6 +1743,8 @@ TerrainManager::TerrainManager()
 
 TerrainManager::~TerrainManager()
 {
+    m_preloader.Deactivate();
+
     for (auto& it : i_TerrainMap)
         delete it.second;
 }
@@ -1348,7 +1756,7 @@ TerrainInfo* TerrainManager::LoadTerrain(const uint32 mapId)
     TerrainDataMap::const_iterator iter = i_TerrainMap.find(mapId);
     if (iter == i_TerrainMap.end())
     {
-        TerrainInfo* info = new TerrainInfo(mapId);
+        TerrainInfo* info = new TerrainInfo(mapId, m_preloader);
         i_TerrainMap[mapId] = info;
         return info;
     }
@@ -1384,6 +1792,8 @@ void TerrainManager::Update(const uint32 diff)
 
 void TerrainManager::UnloadAll()
 {
+    m_preloader.Deactivate();
+
     for (auto& it : i_TerrainMap)
         delete it.second;
 
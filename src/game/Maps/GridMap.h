@@ -25,9 +25,14 @@
 #include "Entities/ObjectDefines.h"
 
 #include "Maps/GridMapDefines.h"
+#include "Maps/TerrainPreloader.h"
 
 #include <atomic>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 class Creature;
 class Unit;
@@ -50,22 +55,22 @@ class GridMap
 
         // Area data
         uint16 m_gridArea;
-        uint16* m_area_map;
+        uint16 const* m_area_map;
 
         // Height level data
         float m_gridHeight;
         float m_gridIntHeightMultiplier;
         union
         {
-            float* m_V9;
-            uint16* m_uint16_V9;
-            uint8* m_uint8_V9;
+            float const* m_V9;
+            uint16 const* m_uint16_V9;
+            uint8 const* m_uint8_V9;
         };
         union
         {
-            float* m_V8;
-            uint16* m_uint16_V8;
-            uint8* m_uint8_V8;
+            float const* m_V8;
+            uint16 const* m_uint16_V8;
+            uint8 const* m_uint8_V8;
         };
 
         // Liquid data
@@ -76,17 +81,28 @@ class GridMap
         uint8 m_liquid_width;
         uint8 m_liquid_height;
         float m_liquidLevel;
-        uint16* m_liquidEntry;
-        uint8* m_liquidFlags;
-        float* m_liquid_map;
+        uint16 const* m_liquidEntry;
+        uint8 const* m_liquidFlags;
+        float const* m_liquid_map;
 
         // For fast check
         bool m_fullyLoaded;
 
-        bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-        bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-        bool loadGridMapLiquidData(FILE* in, uint32 offset, uint32 size);
-        bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+        // the whole .map file, mapped or read, the data arrays above point into it
+        uint8* m_fileData;
+        size_t m_fileSize;
+        bool m_fileMapped;
+        std::vector<std::unique_ptr<uint8[]>> m_alignedCopies;
+
+        bool mapFile(char const* filename);
+        bool readFile(char const* filename);
+        template<typename T> T const* getFileArray(uint32 offset, uint32 count);
+        template<typename T> bool readFileHeader(uint32 offset, T& header) const;
+
+        bool loadAreaData(uint32 offset, uint32 size);
+        bool loadHeightData(uint32 offset, uint32 size);
+        bool loadGridMapLiquidData(uint32 offset, uint32 size);
+        bool loadHolesData(uint32 offset, uint32 size);
         bool isHole(int row, int col) const;
 
         // Get height functions and pointers
@@ -97,12 +113,16 @@ class GridMap
         float getHeightFromUint8(float x, float y) const;
         float getHeightFromFlat(float x, float y) const;
 
+        // Batched height: corners gathered per point, triangle selection and interpolation vectorized
+        template<typename T> void getHeightsFromData(T const* V9, T const* V8, float const* x, float const* y, float* heights, uint32 count) const;
+
     public:
 
         GridMap();
         ~GridMap();
 
-        bool loadData(char const* filename);
+        // mapped: map the file read only instead of reading it, not available on Windows
+        bool loadData(char const* filename, bool mapped = false);
         void unloadData();
         bool IsFullyLoaded() const { return m_fullyLoaded; }
         void SetFullyLoaded() { m_fullyLoaded = true; }
@@ -113,6 +133,8 @@ class GridMap
         uint16 getArea(float x, float y) const;
 
         inline float getHeight(float x, float y) const { return (this->*m_gridGetHeight)(x, y); }
+        // same result as getHeight for count points inside this grid
+        void getHeights(float const* x, float const* y, float* heights, uint32 count) const;
         float getLiquidLevel(float x, float y) const;
         uint8 getTerrainType(float x, float y) const;
         GridMapLiquidStatus getLiquidStatus(float x, float y, float z, uint8 ReqLiquidType, GridMapLiquidData* data = nullptr, float collisionHeight = 2.03128f);
@@ -139,7 +161,7 @@ class Referencable
 class TerrainInfo : public Referencable<std::atomic_long>
 {
     public:
-        TerrainInfo(uint32 mapid);
+        TerrainInfo(uint32 mapid, TerrainPreloader& preloader);
         ~TerrainInfo();
 
         uint32 GetMapId() const { return m_mapId; }
@@ -147,6 +169,8 @@ class TerrainInfo : public Referencable<std::atomic_long>
         // TODO: move all terrain/vmaps data info query functions
         // from 'Map' class into this class
         float GetHeightStatic(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+        // GetHeightStatic of count points, .map heights of points sharing a grid are interpolated together
+        void GetHeightsStatic(uint32 count, float const* x, float const* y, float const* z, float* heights, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         float GetWaterLevel(float x, float y, float z, float* pGround = nullptr) const;
         float GetWaterOrGroundLevel(float x, float y, float z, float& groundZ, bool swim = false, float minWaterDeep = DEFAULT_COLLISION_HEIGHT) const;
         bool IsInWater(float x, float y, float z, GridMapLiquidData* data = nullptr) const;
@@ -175,6 +199,9 @@ class TerrainInfo : public Referencable<std::atomic_long>
 
         bool CanCheckLiquidLevel(float x, float y) const;
 
+        // reads the files of the grid on a preload thread, only called by TerrainPreloader
+        void PreloadGrid(const uint32 x, const uint32 y);
+
     protected:
         friend class Map;
         friend class ObjectMgr;
@@ -182,31 +209,56 @@ class TerrainInfo : public Referencable<std::atomic_long>
         GridMap* Load(const uint32 x, const uint32 y, bool mapOnly = false);
         void Unload(const uint32 x, const uint32 y);
 
+        // queues reading the files of a grid ahead of Load, the grid is kept referenced
+        // until a later clean up, so a map reaching it in time does not touch the disk
+        bool Preload(const uint32 x, const uint32 y);
+        bool IsPreloading(const uint32 x, const uint32 y) const { return m_GridPreload[x][y] == GRID_PRELOAD_QUEUED; }
+
     private:
         TerrainInfo(const TerrainInfo&);
         TerrainInfo& operator=(const TerrainInfo&);
 
         GridMap* GetGrid(const float x, const float y, bool loadOnlyMap = false);
         GridMap* LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnly = false);
+        GridMap* CreateGridMap(const uint32 x, const uint32 y) const;
+
+        // part of the single point query following the .map height lookup
+        float SelectHeightStatic(float x, float y, float z, float mapHeight, bool useVmaps, float maxSearchDist) const;
 
         int RefGrid(const uint32& x, const uint32& y);
         int UnrefGrid(const uint32& x, const uint32& y);
 
+        void ReleasePreload(const uint32 x, const uint32 y);
+
+        enum GridPreloadState
+        {
+            GRID_PRELOAD_NONE,
+            GRID_PRELOAD_QUEUED,
+            GRID_PRELOAD_DONE,
+            GRID_PRELOAD_EXPIRING,                          // released at the next clean up
+        };
+
         const uint32 m_mapId;
 
         GridMap* m_GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         bool m_GridMapsLoadAttempted[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         int16 m_GridRef[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        std::atomic<uint8> m_GridPreload[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+
+        // world models referenced by preloads, x << 8 | y to model names
+        std::unordered_map<uint32, std::vector<std::string>> m_preloadedModels;
 
         // global garbage collection timer
         ShortIntervalTimer i_timer;
 
         VMAP::IVMapManager* m_vmgr;
+        TerrainPreloader& m_preloader;
 
         typedef std::mutex LOCK_TYPE;
         typedef std::lock_guard<LOCK_TYPE> LOCK_GUARD;
         LOCK_TYPE m_mutex;
         LOCK_TYPE m_refMutex;
+        LOCK_TYPE m_preloadMutex;
 };
 
 // class for managing TerrainData object and all sort of geometry querying operations
@@ -222,6 +274,8 @@ class TerrainManager : public MaNGOS::Singleton<TerrainManager, MaNGOS::ClassLev
         void Update(const uint32 diff);
         void UnloadAll();
 
+        TerrainPreloader& GetPreloader() { return m_preloader; }
+
         uint16 GetAreaFlag(uint32 mapid, float x, float y, float z) const
         {
             TerrainInfo* pData = const_cast<TerrainManager*>(this)->LoadTerrain(mapid);
@@ -253,6 +307,7 @@ class TerrainManager : public MaNGOS::Singleton<TerrainManager, MaNGOS::ClassLev
 
         typedef MaNGOS::ClassLevelLockable<TerrainManager, std::mutex>::Lock Guard;
         TerrainDataMap i_TerrainMap;
+        TerrainPreloader m_preloader;
 };
 
 #define sTerrainMgr TerrainManager::Instance()
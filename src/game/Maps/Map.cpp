@@ -36,6 +36,7 @@
 #include "Server/DBCEnums.h"
 #include "VMapFactory.h"
 #include "MotionGenerators/MoveMap.h"
+#include "MotionGenerators/PathMovementGenerator.h"
 #include "Chat/Chat.h"
 #include "Weather/Weather.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
@@ -254,6 +255,7 @@ template<>
 void Map::AddToGrid(Player* obj, NGridType* grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).AddWorldObject(obj);
+    obj->UpdateGridIndex();
 }
 
 template<>
@@ -286,6 +288,7 @@ void Map::AddToGrid(Creature* obj, NGridType* grid, Cell const& cell)
         (*grid)(cell.CellX(), cell.CellY()).AddGridObject<Creature>(obj);
         obj->SetCurrentCell(cell);
     }
+    obj->UpdateGridIndex();
 }
 
 template<class T>
@@ -384,6 +387,66 @@ void Map::EnsureGridLoadedAtEnter(const Cell& cell, Player* player)
         AddToGrid(player, grid, cell);
 }
 
+void Map::PreloadGridsAhead(Player* player)
+{
+    if (!sTerrainMgr.GetPreloader().IsActive() || (!player->IsMoving() && !player->IsTaxiFlying()))
+        return;
+
+    float speed = player->IsTaxiFlying() ? TAXI_FLIGHT_SPEED : player->GetSpeed(player->IsFlying() ? MOVE_FLIGHT : MOVE_RUN);
+    float distance = speed * sWorld.getConfig(CONFIG_UINT32_TERRAIN_PRELOAD_LOOKAHEAD) + GetVisibilityDistance();
+
+    // every grid crossed on the way is requested, the line is followed in half grid steps
+    float const step = SIZE_OF_GRIDS / 2;
+    uint32 const steps = uint32(ceil(distance / step));
+    GridPair const current = MaNGOS::ComputeGridPair(player->GetPositionX(), player->GetPositionY());
+    for (uint32 i = 1; i <= steps; ++i)
+    {
+        float dist = std::min(i * step, distance);
+        float x = player->GetPositionX() + dist * cos(player->GetOrientation());
+        float y = player->GetPositionY() + dist * sin(player->GetOrientation());
+        if (!MaNGOS::IsValidMapCoord(x, y))
+            break;
+
+        CellPair cellPair = MaNGOS::ComputeCellPair(x, y);
+        Cell cell(cellPair);
+        GridPair grid(cell.GridX(), cell.GridY());
+        if (grid == current || loaded(grid))
+            continue;
+
+        int gx = (MAX_NUMBER_OF_GRIDS - 1) - grid.x_coord;
+        int gy = (MAX_NUMBER_OF_GRIDS - 1) - grid.y_coord;
+        if (!m_bLoadedGrids[gx][gy])
+            m_TerrainData->Preload(gx, gy);
+
+        if (std::find_if(m_preloadedGrids.begin(), m_preloadedGrids.end(), [&grid](CellPair const& queued)
+            {
+                Cell queuedCell(queued);
+                return queuedCell.GridX() == grid.x_coord && queuedCell.GridY() == grid.y_coord;
+            }) == m_preloadedGrids.end())
+            m_preloadedGrids.push_back(cellPair);
+    }
+}
+
+void Map::LoadPreloadedGrid()
+{
+    while (!m_preloadedGrids.empty())
+    {
+        Cell cell(m_preloadedGrids.front());
+
+        // objects are only created once the files were read
+        if (m_TerrainData->IsPreloading((MAX_NUMBER_OF_GRIDS - 1) - cell.GridX(), (MAX_NUMBER_OF_GRIDS - 1) - cell.GridY()))
+            return;
+
+        m_preloadedGrids.pop_front();
+        if (loaded(GridPair(cell.GridX(), cell.GridY())))
+            continue;
+
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading preloaded grid[%u,%u] for map %u", cell.GridX(), cell.GridY(), i_id);
+        EnsureGridLoaded(cell);
+        return;
+    }
+}
+
 bool Map::EnsureGridLoaded(const Cell& cell)
 {
     EnsureGridCreated(GridPair(cell.GridX(), cell.GridY()));
@@ -719,6 +782,9 @@ void Map::Update(const uint32& t_diff)
     GetMessager().Execute(this);
     m_spawnManager.Update();
 
+    // grids entered soon get their objects ahead, one per update to spread the load
+    LoadPreloadedGrid();
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
@@ -1006,6 +1072,8 @@ void Map::Update(const uint32& t_diff)
 #ifdef BUILD_METRICS
     meas.add_field("count", std::to_string(static_cast<int32>(count)));
 #endif
+    m_updateStats.objectCount = uint32(count);
+    m_updateStats.playerCount = m_mapRefManager.getSize();
 
     // Send world objects and item update field changes
     SendObjectUpdates();
@@ -1034,6 +1102,16 @@ void Map::Update(const uint32& t_diff)
     m_weatherSystem->UpdateWeathers(t_diff);
 }
 
+void Map::RecordUpdateDuration(std::chrono::microseconds duration)
+{
+    m_updateStats.lastDuration = duration;
+    m_updateStats.maxDuration = std::max(m_updateStats.maxDuration, duration);
+    if (m_updateStats.updateCount++ == 0)
+        m_updateStats.averageDuration = duration;
+    else
+        m_updateStats.averageDuration += (duration - m_updateStats.averageDuration) / 8;
+}
+
 void Map::Remove(Player* player, bool remove)
 {
     if (i_data)
@@ -1168,6 +1246,9 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
         ResetGridExpiry(*newGrid, 0.1f);
         newGrid->SetGridState(GRID_STATE_ACTIVE);
     }
+
+    if (!same_cell)
+        PreloadGridsAhead(player);
 }
 
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang)
@@ -2853,6 +2934,17 @@ float Map::GetHeight(float x, float y, float z, bool swim) const
     return std::max<float>(staticHeight, m_dyn_tree.getHeight(x, y, dynSearchHeight, dynSearchHeight - staticHeight));
 }
 
+void Map::GetHeights(uint32 count, float const* x, float const* y, float const* z, float* heights, bool swim) const
+{
+    m_TerrainData->GetHeightsStatic(count, x, y, z, heights, true, (swim ? DEFAULT_WATER_SEARCH : DEFAULT_HEIGHT_SEARCH));
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        float dynSearchHeight = 2.0f + (z[i] < heights[i] ? heights[i] : z[i]);
+        heights[i] = std::max<float>(heights[i], m_dyn_tree.getHeight(x[i], y[i], dynSearchHeight, dynSearchHeight - heights[i]));
+    }
+}
+
 void Map::InsertGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.insert(mdl);
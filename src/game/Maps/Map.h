@@ -42,6 +42,8 @@
 #include "World/WorldStateVariableManager.h"
 
 #include <bitset>
+#include <chrono>
+#include <deque>
 #include <functional>
 #include <list>
 
@@ -126,6 +128,19 @@ struct ZoneDynamicInfo
 
 typedef std::unordered_map<uint32 /*zoneId*/, ZoneDynamicInfo> ZoneDynamicInfoMap;
 
+// Rolling cost of Map::Update, used to order and distribute map updates over the updater threads
+struct MapUpdateStatistics
+{
+    MapUpdateStatistics() : lastDuration(0), averageDuration(0), maxDuration(0), objectCount(0), playerCount(0), updateCount(0) {}
+
+    std::chrono::microseconds lastDuration;
+    std::chrono::microseconds averageDuration;              // exponential moving average over roughly the last 8 updates
+    std::chrono::microseconds maxDuration;
+    uint32 objectCount;                                     // objects updated in the last tick
+    uint32 playerCount;
+    uint32 updateCount;
+};
+
 class Map : public GridRefManager<NGridType>
 {
         friend class MapReference;
@@ -336,6 +351,11 @@ class Map : public GridRefManager<NGridType>
             i_objectsToClientUpdate.erase(obj);
         }
 
+        // wall time of the last Map::Update call done by the MapUpdater
+        std::chrono::microseconds GetLastUpdateDuration() const { return m_updateStats.lastDuration; }
+        void RecordUpdateDuration(std::chrono::microseconds duration);
+        MapUpdateStatistics const& GetUpdateStatistics() const { return m_updateStats; }
+
         // DynObjects currently
         uint32 GenerateLocalLowGuid(HighGuid guidhigh);
 
@@ -352,6 +372,7 @@ class Map : public GridRefManager<NGridType>
 
         // Dynamic VMaps
         float GetHeight(float x, float y, float z, bool swim = false) const;
+        void GetHeights(uint32 count, float const* x, float const* y, float const* z, float* heights, bool swim = false) const;
         bool GetHeightInRange(float x, float y, float& z, float maxSearchDist = 4.0f) const;
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model) const;
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, float modifyDist) const;
@@ -451,6 +472,11 @@ class Map : public GridRefManager<NGridType>
         bool EnsureGridLoaded(Cell const&);
         void EnsureGridLoadedAtEnter(Cell const&, Player* player = nullptr);
 
+        // reads ahead the terrain of grids a moving player is heading to
+        void PreloadGridsAhead(Player* player);
+        // loads the objects of one of those grids per update
+        void LoadPreloadedGrid();
+
         void buildNGridLinkage(NGridType* pNGridType) { pNGridType->link(this); }
 
         NGridType* getNGrid(uint32 x, uint32 y) const
@@ -469,6 +495,8 @@ class Map : public GridRefManager<NGridType>
         void SendObjectUpdates();
         std::set<Object*> i_objectsToClientUpdate;
 
+        MapUpdateStatistics m_updateStats;
+
     protected:
         MapEntry const* i_mapEntry;
         uint8 i_spawnMode;
@@ -506,6 +534,7 @@ class Map : public GridRefManager<NGridType>
         // Shared geodata object with map coord info...
         TerrainInfo* const m_TerrainData;
         bool m_bLoadedGrids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        std::deque<CellPair> m_preloadedGrids;
 
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
 
@@ -30,6 +30,10 @@
 #include "BattleGround/BattleGroundMgr.h"
 #include <future>
 
+#ifdef BUILD_METRICS
+#include "Metric/Metric.h"
+#endif
+
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex>
 INSTANTIATE_SINGLETON_2(MapManager, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(MapManager, std::recursive_mutex);
@@ -56,6 +60,9 @@ void MapManager::Initialize()
     int num_threads(sWorld.getConfig(CONFIG_UINT32_NUM_MAP_THREADS));
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (uint32 preloadThreads = sWorld.getConfig(CONFIG_UINT32_TERRAIN_PRELOAD_THREADS))
+        sTerrainMgr.GetPreloader().Activate(preloadThreads);
 }
 
 void MapManager::InitStateMachine()
@@ -196,16 +203,38 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
-    for (auto& map : i_maps)
+    if (m_updater.activated())
     {
-        if (m_updater.activated())
-            m_updater.schedule_update(new MapUpdateWorker(*map.second, (uint32)i_timer.GetCurrent(), m_updater));
-        else
-            map.second->Update((uint32)i_timer.GetCurrent());
-    }
+        // most expensive maps first, so one heavy map does not start last and stretch the tick
+        m_updateOrder = GetMapsByUpdateCost();
+
+        while (m_updateWorkers.size() < m_updateOrder.size())
+            m_updateWorkers.push_back(std::make_unique<MapUpdateWorker>(m_updater));
+
+        // greedy bin-packing, every map goes to the thread with the least expected work so far
+        // mispredictions are still balanced by work stealing
+        std::vector<std::chrono::microseconds> threadLoad(m_updater.GetThreadCount(), std::chrono::microseconds(0));
+        for (size_t i = 0; i < m_updateOrder.size(); ++i)
+        {
+            Map* map = m_updateOrder[i];
+            size_t thread = std::min_element(threadLoad.begin(), threadLoad.end()) - threadLoad.begin();
+            threadLoad[thread] += std::max(map->GetUpdateStatistics().averageDuration, std::chrono::microseconds(1));
+
+            m_updateWorkers[i]->Reset(*map, (uint32)i_timer.GetCurrent());
+            m_updater.schedule_update(m_updateWorkers[i].get(), thread);
+        }
 
-    if (m_updater.activated())
         m_updater.wait();
+    }
+    else
+    {
+        for (auto& map : i_maps)
+        {
+            auto startTime = std::chrono::steady_clock::now();
+            map.second->Update((uint32)i_timer.GetCurrent());
+            map.second->RecordUpdateDuration(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime));
+        }
+    }
 
     // remove all maps which can be unloaded
     MapMapType::iterator iter = i_maps.begin();
@@ -225,6 +254,44 @@ void MapManager::Update(uint32 diff)
     i_timer.SetCurrent(0);
 }
 
+std::vector<Map*> MapManager::GetMapsByUpdateCost() const
+{
+    std::vector<Map*> maps;
+    maps.reserve(i_maps.size());
+    for (auto& map : i_maps)
+        maps.push_back(map.second.get());
+
+    std::stable_sort(maps.begin(), maps.end(), [](Map const* left, Map const* right)
+    {
+        MapUpdateStatistics const& leftStats = left->GetUpdateStatistics();
+        MapUpdateStatistics const& rightStats = right->GetUpdateStatistics();
+        if (leftStats.averageDuration != rightStats.averageDuration)
+            return leftStats.averageDuration > rightStats.averageDuration;
+        // not measured yet, object count is the best guess
+        return leftStats.objectCount > rightStats.objectCount;
+    });
+
+    return maps;
+}
+
+#ifdef BUILD_METRICS
+void MapManager::GenerateMetrics() const
+{
+    for (auto& map : i_maps)
+    {
+        MapUpdateStatistics const& stats = map.second->GetUpdateStatistics();
+        metric::measurement meas("map.update.cost", {
+            { "map_id", std::to_string(map.first.nMapId) },
+            { "instance_id", std::to_string(map.first.nInstanceId) }
+        });
+        meas.add_field("avg_us", std::to_string(static_cast<int64>(stats.averageDuration.count())));
+        meas.add_field("max_us", std::to_string(static_cast<int64>(stats.maxDuration.count())));
+        meas.add_field("objects", std::to_string(stats.objectCount));
+        meas.add_field("players", std::to_string(stats.playerCount));
+    }
+}
+#endif
+
 void MapManager::RemoveAllObjectsInRemoveList()
 {
     for (auto& i_map : i_maps)
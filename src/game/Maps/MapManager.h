@@ -29,9 +29,11 @@
 #include "Util/UniqueTrackablePtr.h"
 
 #include <functional>
+#include <memory>
 
 class Transport;
 class BattleGround;
+class MapUpdateWorker;
 struct TransportTemplate;
 
 struct MapID
@@ -151,6 +153,12 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         // get list of all maps
         const MapMapType& Maps() const { return i_maps; }
 
+        // loaded maps, most expensive update first
+        std::vector<Map*> GetMapsByUpdateCost() const;
+#ifdef BUILD_METRICS
+        void GenerateMetrics() const;
+#endif
+
         template<typename Check> inline WorldObject* SearchOnAllLoadedMap(Check& check);
         void DoForAllMaps(const std::function<void(Map*)>& worker);
         void DoForAllMapsWithMapId(uint32 mapId, const std::function<void(Map*)> worker);
@@ -183,6 +191,8 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         std::atomic<uint32> i_MaxInstanceId;
         MapUpdater m_updater;
+        std::vector<std::unique_ptr<MapUpdateWorker>> m_updateWorkers; // pooled, reassigned every tick
+        std::vector<Map*> m_updateOrder;
 };
 
 template<typename Check>
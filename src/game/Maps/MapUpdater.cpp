@@ -19,10 +19,13 @@
 #include "MapUpdater.h"
 #include "MapWorkers.h"
 
-MapUpdater::MapUpdater(size_t num_threads) : _cancelationToken(false), pending_requests(0)
+// pool thread index of the calling thread, used to schedule nested tasks locally
+static thread_local MapUpdater const* t_updater = nullptr;
+static thread_local size_t t_queueIndex = 0;
+
+MapUpdater::MapUpdater(size_t num_threads) : MapUpdater()
 {
-    for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+    activate(num_threads);
 }
 
 void MapUpdater::activate(size_t num_threads)
@@ -30,26 +33,35 @@ void MapUpdater::activate(size_t num_threads)
     if (activated())
         return;
 
+    _cancelationToken = false;
+
+    for (size_t i = 0; i < num_threads; ++i)
+        _queues.push_back(std::make_unique<TaskQueue>());
+
     for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
 }
 
 void MapUpdater::deactivate()
 {
-    _cancelationToken = true;
-
-    _queue.Cancel();
+    {
+        std::lock_guard<std::mutex> lock(_sleepLock);
+        _cancelationToken = true;
+    }
+    _condition.notify_all();
 
     for (auto& thread : _workerThreads)
         thread.join();
+
+    _workerThreads.clear();
+    _queues.clear();
+    _queued = 0;
 }
 
 void MapUpdater::wait()
 {
-    std::unique_lock<std::mutex> lock(_lock);
-
-    while (pending_requests > 0)
-        _condition.wait(lock);
+    for (size_t pending = _pending.load(); pending > 0; pending = _pending.load())
+        _pending.wait(pending);
 }
 
 void MapUpdater::join()
@@ -65,36 +77,88 @@ bool MapUpdater::activated()
 
 void MapUpdater::update_finished()
 {
-    std::lock_guard<std::mutex> lock(_lock);
-
-    --pending_requests;
-    _condition.notify_all();
+    // only the last finished task releases the latch
+    if (--_pending == 0)
+        _pending.notify_all();
 }
 
 void MapUpdater::schedule_update(Worker* worker)
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    // nested tasks stay on the scheduling thread, idle threads steal them from there
+    schedule_update(worker, t_updater == this ? t_queueIndex : _nextQueue++ % _queues.size());
+}
+
+void MapUpdater::schedule_update(Worker* worker, size_t threadIndex)
+{
+    ++_pending;
 
-    ++pending_requests;
-    _queue.Push(std::move(worker));
+    size_t index = threadIndex % _queues.size();
+    {
+        TaskQueue& queue = *_queues[index];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.tasks.push_back(worker);
+    }
+
+    ++_queued;
+    if (_sleeping > 0)
+    {
+        std::lock_guard<std::mutex> lock(_sleepLock);
+        _condition.notify_one();
+    }
+}
+
+Worker* MapUpdater::PopTask(size_t index)
+{
+    TaskQueue& queue = *_queues[index];
+    std::lock_guard<std::mutex> lock(queue.lock);
+    if (queue.tasks.empty())
+        return nullptr;
+
+    Worker* worker = queue.tasks.front();
+    queue.tasks.pop_front();
+    --_queued;
+    return worker;
 }
 
-void MapUpdater::WorkerThread()
+Worker* MapUpdater::StealTask(size_t thief)
 {
-    while (true)
+    for (size_t i = 1; i < _queues.size(); ++i)
     {
-        Worker* request = nullptr;
+        TaskQueue& queue = *_queues[(thief + i) % _queues.size()];
+        std::unique_lock<std::mutex> lock(queue.lock, std::try_to_lock);
+        if (!lock.owns_lock() || queue.tasks.empty())
+            continue;
+
+        // owners work from the front, so the cheapest scheduled work is taken
+        Worker* worker = queue.tasks.back();
+        queue.tasks.pop_back();
+        --_queued;
+        return worker;
+    }
+
+    return nullptr;
+}
+
+void MapUpdater::WorkerThread(size_t index)
+{
+    t_updater = this;
+    t_queueIndex = index;
 
-        _queue.WaitAndPop(request);
+    while (!_cancelationToken)
+    {
+        Worker* request = PopTask(index);
+        if (!request)
+            request = StealTask(index);
 
-        if (_cancelationToken)
+        if (request)
         {
-            delete request;
-            return;
+            request->execute();
+            continue;
         }
 
-        request->execute();
-
-        delete request;
+        std::unique_lock<std::mutex> lock(_sleepLock);
+        ++_sleeping;
+        _condition.wait(lock, [this]() { return _queued > 0 || _cancelationToken; });
+        --_sleeping;
     }
-}
\ No newline at end of file
+}
@@ -20,23 +20,32 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Platform/Define.h"
-#include "Util/ProducerConsumerQueue.h"
 
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <condition_variable>
 
 class Worker;
 
+/**
+ * Work-stealing thread pool used for map updates.
+ *
+ * Every thread owns a deque of tasks. External submissions are spread round-robin over the
+ * deques in submission order, tasks scheduled from inside a pool thread go to its own deque.
+ * Owners take tasks from the front, idle threads steal from the back of the other deques.
+ * Tasks are not owned by the updater, the scheduling side keeps them alive until executed.
+ */
 class MapUpdater
 {
     public:
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
+        MapUpdater() : _cancelationToken(false), _queued(0), _sleeping(0), _pending(0), _nextQueue(0) {}
         MapUpdater(size_t num_threads);
         MapUpdater(const MapUpdater&) = delete;
-        
+
         void activate(size_t num_threads);
         void deactivate();
         void wait();
@@ -44,18 +53,34 @@ class MapUpdater
         bool activated();
         void update_finished();
         void schedule_update(Worker* worker);
+        // places the task on the deque of the given thread, used for cost based distribution
+        void schedule_update(Worker* worker, size_t threadIndex);
+
+        size_t GetThreadCount() const { return _workerThreads.size(); }
 
     private:
-        ProducerConsumerQueue<Worker *> _queue;
+        struct TaskQueue
+        {
+            std::mutex lock;
+            std::deque<Worker*> tasks;
+        };
+
+        Worker* PopTask(size_t index);
+        Worker* StealTask(size_t thief);
 
+        std::vector<std::unique_ptr<TaskQueue>> _queues;
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
 
-        std::mutex _lock;
+        std::atomic<size_t> _queued;                        // tasks waiting in any deque
+        std::atomic<size_t> _sleeping;                      // threads blocked on _condition
+        std::mutex _sleepLock;
         std::condition_variable _condition;
-        size_t pending_requests;
 
-        void WorkerThread();
+        std::atomic<size_t> _pending;                       // latch of wait(), tasks scheduled but not finished
+        std::atomic<size_t> _nextQueue;
+
+        void WorkerThread(size_t index);
 };
 
-#endif //_MAP_UPDATER_H_INCLUDED
\ No newline at end of file
+#endif //_MAP_UPDATER_H_INCLUDED
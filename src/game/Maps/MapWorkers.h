@@ -26,6 +26,8 @@
 #include "Entities/Object.h"
 #include "Platform/Define.h"
 
+#include <chrono>
+
 class Worker
 {
     public:
@@ -40,21 +42,30 @@ class Worker
         MapUpdater& m_updater;
 };
 
+// Pooled by MapManager, assigned to a map again every tick
 class MapUpdateWorker : public Worker
 {
     public:
-        MapUpdateWorker(Map& map, uint32 diff, MapUpdater& updater) :
-            Worker(updater), m_map(map), m_diff(diff)
+        MapUpdateWorker(MapUpdater& updater) :
+            Worker(updater), m_map(nullptr), m_diff(0)
         {}
 
+        void Reset(Map& map, uint32 diff)
+        {
+            m_map = &map;
+            m_diff = diff;
+        }
+
         void execute() override
         {
-            m_map.Update(m_diff);
+            auto startTime = std::chrono::steady_clock::now();
+            m_map->Update(m_diff);
+            m_map->RecordUpdateDuration(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime));
             GetWorker().update_finished();
         }
 
     private:
-        Map& m_map;
+        Map* m_map;
         uint32 m_diff;
 };
 
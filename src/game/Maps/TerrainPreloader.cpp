@@ -0,0 +1,85 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/TerrainPreloader.h"
+#include "Maps/GridMap.h"
+
+#include <algorithm>
+
+void TerrainPreloader::Activate(uint32 threads)
+{
+    if (IsActive())
+        return;
+
+    m_stop = false;
+    for (uint32 i = 0; i < threads; ++i)
+        m_threads.push_back(std::thread(&TerrainPreloader::WorkerThread, this));
+}
+
+void TerrainPreloader::Deactivate()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stop = true;
+        m_tasks.clear();
+    }
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads)
+        thread.join();
+
+    m_threads.clear();
+}
+
+void TerrainPreloader::Queue(TerrainInfo* terrain, uint32 x, uint32 y)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_tasks.push_back({ terrain, x, y });
+    }
+    m_condition.notify_one();
+}
+
+void TerrainPreloader::Cancel(TerrainInfo const* terrain)
+{
+    std::unique_lock<std::mutex> guard(m_lock);
+    m_tasks.erase(std::remove_if(m_tasks.begin(), m_tasks.end(), [terrain](Task const& task) { return task.terrain == terrain; }), m_tasks.end());
+    m_finished.wait(guard, [this, terrain]() { return std::find(m_running.begin(), m_running.end(), terrain) == m_running.end(); });
+}
+
+void TerrainPreloader::WorkerThread()
+{
+    std::unique_lock<std::mutex> guard(m_lock);
+    while (true)
+    {
+        m_condition.wait(guard, [this]() { return !m_tasks.empty() || m_stop; });
+        if (m_stop)
+            break;
+
+        Task task = m_tasks.front();
+        m_tasks.pop_front();
+        m_running.push_back(task.terrain);
+
+        guard.unlock();
+        task.terrain->PreloadGrid(task.x, task.y);
+        guard.lock();
+
+        m_running.erase(std::find(m_running.begin(), m_running.end(), task.terrain));
+        m_finished.notify_all();
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_TERRAINPRELOADER_H
+#define MANGOS_TERRAINPRELOADER_H
+
+#include "Platform/Define.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TerrainInfo;
+
+/**
+ * Background threads reading the terrain, vmap and mmap files of grids before a map needs them.
+ *
+ * Maps queue the grids their moving players are heading to. The preload threads only build
+ * data no map can see yet (the GridMap object, world models of the vmap tile and the raw
+ * navmesh tile), the map thread still inserts vmap and mmap tiles when it loads the grid.
+ */
+class TerrainPreloader
+{
+    public:
+        TerrainPreloader() : m_stop(false) {}
+        TerrainPreloader(const TerrainPreloader&) = delete;
+        ~TerrainPreloader() { Deactivate(); }
+
+        void Activate(uint32 threads);
+        // drops all queued grids, returns once the running ones are done
+        void Deactivate();
+        bool IsActive() const { return !m_threads.empty(); }
+
+        void Queue(TerrainInfo* terrain, uint32 x, uint32 y);
+        // drops queued grids of the terrain, returns once its running ones are done
+        void Cancel(TerrainInfo const* terrain);
+
+    private:
+        struct Task
+        {
+            TerrainInfo* terrain;
+            uint32 x;
+            uint32 y;
+        };
+
+        void WorkerThread();
+
+        std::mutex m_lock;
+        std::condition_variable m_condition;
+        std::condition_variable m_finished;
+        std::deque<Task> m_tasks;
+        std::vector<TerrainInfo const*> m_running;
+        std::vector<std::thread> m_threads;
+        bool m_stop;
+};
+
+#endif
@@ -97,6 +97,9 @@ namespace MMAP
     {
         // by now we should not have maps loaded
         // if we had, tiles in MMapData->mmapLoadedTiles, their actual data is lost!
+
+        for (auto& prefetched : m_prefetchedTiles)
+            dtFree(prefetched.second.data);
     }
 
     bool MMapManager::loadMapData(std::string const& basePath, uint32 mapId)
@@ -211,6 +214,18 @@ namespace MMAP
             return false;
         }
 
+        // use the tile read ahead by the terrain preloader if there is one
+        {
+            std::lock_guard<std::mutex> lock(m_prefetchMutex);
+            auto prefetched = m_prefetchedTiles.find(uint64(mapId) << 32 | packedGridPos);
+            if (prefetched != m_prefetchedTiles.end())
+            {
+                PrefetchedTile tile = prefetched->second;
+                m_prefetchedTiles.erase(prefetched);
+                return addTile(tile.data, tile.size, mmapData, packedGridPos, mapId, x, y);
+            }
+        }
+
         // load this tile :: mmaps/MMMXXYY.mmtile
         uint32 pathLen = basePath.length() + strlen(TILE_FILE_NAME_FORMAT) + 1;
         std::unique_ptr<char[]> fileName(new char[pathLen]);
@@ -219,13 +234,41 @@ namespace MMAP
         return loadMapInternal(fileName.get(), mmapData, packedGridPos, mapId, x, y);
     }
 
-    bool MMapManager::loadMapInternal(const char* filePath, const std::unique_ptr<MMapData>& mmapData, uint32 packedGridPos, uint32 mapId, int32 x, int32 y)
+    bool MMapManager::prefetchTile(std::string const& basePath, uint32 mapId, int32 x, int32 y)
+    {
+        uint32 pathLen = basePath.length() + strlen(TILE_FILE_NAME_FORMAT) + 1;
+        std::unique_ptr<char[]> fileName(new char[pathLen]);
+        snprintf(fileName.get(), pathLen, (basePath + TILE_FILE_NAME_FORMAT).c_str(), mapId, x, y);
+
+        PrefetchedTile tile;
+        tile.data = readTile(fileName.get(), mapId, x, y, tile.size);
+        if (!tile.data)
+            return false;
+
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        if (!m_prefetchedTiles.emplace(uint64(mapId) << 32 | packTileID(x, y), tile).second)
+            dtFree(tile.data);
+        return true;
+    }
+
+    void MMapManager::dropPrefetchedTile(uint32 mapId, int32 x, int32 y)
+    {
+        std::lock_guard<std::mutex> lock(m_prefetchMutex);
+        auto prefetched = m_prefetchedTiles.find(uint64(mapId) << 32 | packTileID(x, y));
+        if (prefetched != m_prefetchedTiles.end())
+        {
+            dtFree(prefetched->second.data);
+            m_prefetchedTiles.erase(prefetched);
+        }
+    }
+
+    unsigned char* MMapManager::readTile(const char* filePath, uint32 mapId, int32 x, int32 y, int& size) const
     {
         FILE* file = fopen(filePath, "rb");
         if (!file)
         {
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "ERROR: MMAP:loadMap: Could not open mmtile file '%s'", filePath);
-            return false;
+            return nullptr;
         }
 
         // read header
@@ -236,7 +279,7 @@ namespace MMAP
         {
             sLog.outError("MMAP:loadMap: Bad header in mmap %03u%02i%02i.mmtile", mapId, x, y);
             fclose(file);
-            return false;
+            return nullptr;
         }
 
         if (fileHeader.mmapVersion != MMAP_VERSION)
@@ -244,7 +287,7 @@ namespace MMAP
             sLog.outError("MMAP:loadMap: %03u%02i%02i.mmtile was built with generator v%i, expected v%i",
                 mapId, x, y, fileHeader.mmapVersion, MMAP_VERSION);
             fclose(file);
-            return false;
+            return nullptr;
         }
 
         unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
@@ -255,16 +298,33 @@ namespace MMAP
         {
             sLog.outError("MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
             fclose(file);
-            return false;
+            dtFree(data);
+            return nullptr;
         }
 
         fclose(file);
 
+        size = fileHeader.size;
+        return data;
+    }
+
+    bool MMapManager::loadMapInternal(const char* filePath, const std::unique_ptr<MMapData>& mmapData, uint32 packedGridPos, uint32 mapId, int32 x, int32 y)
+    {
+        int size;
+        unsigned char* data = readTile(filePath, mapId, x, y, size);
+        if (!data)
+            return false;
+
+        return addTile(data, size, mmapData, packedGridPos, mapId, x, y);
+    }
+
+    bool MMapManager::addTile(unsigned char* data, int size, const std::unique_ptr<MMapData>& mmapData, uint32 packedGridPos, uint32 mapId, int32 x, int32 y)
+    {
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        dtStatus dtResult = mmapData->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
+        dtStatus dtResult = mmapData->navMesh->addTile(data, size, DT_TILE_FREE_DATA, 0, &tileRef);
         if (dtStatusFailed(dtResult))
         {
             sLog.outError("MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
@@ -99,6 +99,10 @@ namespace MMAP
             void loadAllMapTiles(std::string const& basePath, uint32 mapId);
             bool loadMap(std::string const& basePath, uint32 mapId, int32 x, int32 y);
             bool loadMapInternal(const char* filePath, const std::unique_ptr<MMapData>& mmapData, uint32 packedGridPos, uint32 mapId, int32 x, int32 y);
+            // reads a tile file without touching the navmesh, safe from any thread
+            // the next loadMap of the tile adds the read data instead of opening the file
+            bool prefetchTile(std::string const& basePath, uint32 mapId, int32 x, int32 y);
+            void dropPrefetchedTile(uint32 mapId, int32 x, int32 y);
             void loadAllGameObjectModels(std::string const& basePath, std::vector<uint32> const& displayIds);
             bool loadGameObject(std::string const& basePath, uint32 displayId);
             bool loadMapInstance(std::string const& basePath, uint32 mapId, uint32 instanceId);
@@ -121,6 +125,14 @@ namespace MMAP
         private:
             bool loadMapData(std::string const& basePath, uint32 mapId);
             uint32 packTileID(int32 x, int32 y) const;
+            unsigned char* readTile(const char* filePath, uint32 mapId, int32 x, int32 y, int& size) const;
+            bool addTile(unsigned char* data, int size, const std::unique_ptr<MMapData>& mmapData, uint32 packedGridPos, uint32 mapId, int32 x, int32 y);
+
+            struct PrefetchedTile
+            {
+                unsigned char* data;
+                int size;
+            };
 
             std::unordered_map<uint32, std::unique_ptr<MMapData>> loadedMMaps;
             std::atomic<uint32> loadedTiles;
@@ -128,6 +140,9 @@ namespace MMAP
             std::unordered_map<uint32, std::unique_ptr<MMapGOData>> m_loadedModels;
             std::mutex m_modelsMutex;
 
+            std::unordered_map<uint64, PrefetchedTile> m_prefetchedTiles;   // mapId << 32 | tile id
+            std::mutex m_prefetchMutex;
+
             bool m_enabled;
     };
 
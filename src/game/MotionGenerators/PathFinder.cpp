@@ -991,13 +991,25 @@ void PathFinder::NormalizePath()
 
     GenericTransport* transport = m_sourceUnit->GetTransport();
 
-    for (auto& m_pathPoint : m_pathPoints)
+    // heights of all points are looked up in one batch
+    uint32 count = m_pathPoints.size();
+    std::vector<float> x(count), y(count), z(count);
+    for (uint32 i = 0; i < count; ++i)
     {
+        x[i] = m_pathPoints[i].x;
+        y[i] = m_pathPoints[i].y;
+        z[i] = m_pathPoints[i].z;
         if (transport)
-            transport->CalculatePassengerPosition(m_pathPoint.x, m_pathPoint.y, m_pathPoint.z);
-        m_sourceUnit->UpdateAllowedPositionZ(m_pathPoint.x, m_pathPoint.y, m_pathPoint.z);
+            transport->CalculatePassengerPosition(x[i], y[i], z[i]);
+    }
+
+    m_sourceUnit->UpdateAllowedPositionsZ(count, x.data(), y.data(), z.data());
+
+    for (uint32 i = 0; i < count; ++i)
+    {
         if (transport)
-            transport->CalculatePassengerOffset(m_pathPoint.x, m_pathPoint.y, m_pathPoint.z);
+            transport->CalculatePassengerOffset(x[i], y[i], z[i]);
+        m_pathPoints[i] = Vector3(x[i], y[i], z[i]);
     }
 }
 
@@ -371,8 +371,6 @@ bool TaxiMovementGenerator::Update(Unit& unit, const uint32& diff)
     return (movement || Resume(player));
 }
 
-#define TAXI_FLIGHT_SPEED        32.0f
-
 bool TaxiMovementGenerator::Move(Unit& unit)
 {
     Movement::MoveSplineInit init(unit);
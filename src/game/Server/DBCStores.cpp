@@ -215,6 +215,8 @@ static bool LoadDBC_assert_print(uint32 fsize, uint32 rsize, const std::string&
     return false;
 }
 
+static bool dbcMapFiles = false;                            // set for the LoadDBCStores call
+
 template<class T>
 inline void LoadDBC(uint32& availableDbcLocales, BarGoLink& bar, StoreProblemList& errlist, DBCStorage<T>& storage, const std::string& dbc_path, const std::string& filename)
 {
@@ -222,7 +224,7 @@ inline void LoadDBC(uint32& availableDbcLocales, BarGoLink& bar, StoreProblemLis
     MANGOS_ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
 
     std::string dbc_filename = dbc_path + filename;
-    if (storage.Load(dbc_filename.c_str()))
+    if (storage.Load(dbc_filename.c_str(), dbcMapFiles))
     {
         bar.step();
         for (uint8 i = 0; fullLocaleNameList[i].name; ++i)
@@ -231,7 +233,7 @@ inline void LoadDBC(uint32& availableDbcLocales, BarGoLink& bar, StoreProblemLis
                 continue;
 
             std::string dbc_filename_loc = dbc_path + fullLocaleNameList[i].name + "/" + filename;
-            if (!storage.LoadStringsFrom(dbc_filename_loc.c_str()))
+            if (!storage.LoadStringsFrom(dbc_filename_loc.c_str(), dbcMapFiles))
                 availableDbcLocales &= ~(1 << i);           // mark as not available for speedup next checks
         }
     }
@@ -251,9 +253,10 @@ inline void LoadDBC(uint32& availableDbcLocales, BarGoLink& bar, StoreProblemLis
     }
 }
 
-void LoadDBCStores(const std::string& dataPath)
+void LoadDBCStores(const std::string& dataPath, bool mapFiles)
 {
     std::string dbcPath = dataPath + "dbc/";
+    dbcMapFiles = mapFiles;
 
     if (!MaNGOS::Filesystem::exists(dbcPath))
     {
@@ -105,7 +105,8 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetStorageLocaleIndexFor(locale)),
     m_latency(0), m_tutorialState(TUTORIALDATA_UNCHANGED),
     m_timeSyncClockDeltaQueue(6), m_timeSyncClockDelta(0), m_pendingTimeSyncRequests(), m_timeSyncNextCounter(0), m_timeSyncTimer(0),
-    m_recruitingFriendId(recruitingFriend), m_isRecruiter(isARecruiter)
+    m_recruitingFriendId(recruitingFriend), m_isRecruiter(isARecruiter),
+    m_recvQueue(sWorld.getConfig(CONFIG_UINT32_SESSION_PACKET_BACKLOG)), m_recvQueueMap(sWorld.getConfig(CONFIG_UINT32_SESSION_PACKET_BACKLOG)), m_movementPacketsDeletedBefore(0)
     {}
 
 /// WorldSession destructor
@@ -262,7 +263,7 @@ void WorldSession::SendPacket(WorldPacket const& packet, bool forcedSend /*= fal
 }
 
 /// Add an incoming packet to the queue
-void WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
+bool WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
 {
     sWorld.IncrementOpcodeCounter(new_packet->GetOpcode());
     OpcodeHandler const& opHandle = opcodeTable[new_packet->GetOpcode()];
@@ -279,39 +280,28 @@ void WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
 
         if (new_packet->rpos() < new_packet->wpos() && sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
             LogUnprocessedTail(*new_packet);
-        return;
+        return true;
     }
 
-    if (opHandle.packetProcessing == PROCESS_MAP_THREAD)
-    {
-        std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-        m_recvQueueMap.push_back(std::move(new_packet));
-    }
-    else
-    {
-        std::lock_guard<std::mutex> guard(m_recvQueueLock);
-        m_recvQueue.push_back(std::move(new_packet));
-    }
+    // route by the thread the opcode is processed in
+    MPSCQueue<std::unique_ptr<WorldPacket>>& queue = opHandle.packetProcessing == PROCESS_MAP_THREAD ? m_recvQueueMap : m_recvQueue;
+    if (queue.Enqueue(std::move(new_packet)))
+        return true;
+
+    // backlog full, client sends faster than the session processes. Losing a packet would desync the client, so it is disconnected instead
+    sLog.outError("WorldSession::QueuePacket: account %u (address %s) exceeded packet backlog of " SIZEFMTD " at opcode %s (0x%.4X), kicking",
+        GetAccountId(), GetRemoteAddress().c_str(), queue.Capacity(), new_packet->GetOpcodeName(), new_packet->GetOpcode());
+    return false;
 }
 
 void WorldSession::DeleteMovementPackets()
 {
-    std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-    for (auto itr = m_recvQueueMap.begin(); itr != m_recvQueueMap.end();)
-    {
-        switch ((*itr)->GetOpcode())
-        {
-            case MSG_MOVE_SET_FACING:
-            case MSG_MOVE_HEARTBEAT:
-            {
-                itr = m_recvQueueMap.erase(itr);
-                break;
-            }
-            default:
-                ++itr;
-                break;
-        }
-    }
+    // only the map thread may consume the queue, it skips the movement packets queued until now at its next update
+    size_t enqueued = m_recvQueueMap.EnqueuedCount();
+    size_t deletedBefore = m_movementPacketsDeletedBefore.load(std::memory_order_relaxed);
+    while (deletedBefore < enqueued)
+        if (m_movementPacketsDeletedBefore.compare_exchange_weak(deletedBefore, enqueued, std::memory_order_release, std::memory_order_relaxed))
+            break;
 }
 
 /// Logging helper for unexpected opcodes
@@ -360,11 +350,10 @@ bool WorldSession::Update(uint32 /*diff*/)
 {
     GetMessager().Execute(this);
 
+    // only packets received until now are processed this tick
     std::deque<std::unique_ptr<WorldPacket>> recvQueueCopy;
-    {
-        std::lock_guard<std::mutex> guard(m_recvQueueLock);
-        std::swap(recvQueueCopy, m_recvQueue);
-    }
+    for (std::unique_ptr<WorldPacket> packet; m_recvQueue.Dequeue(packet);)
+        recvQueueCopy.push_back(std::move(packet));
 
     if (m_socket && !m_socket->IsClosed() && m_anticheat)
     {
@@ -464,11 +453,9 @@ bool WorldSession::Update(uint32 /*diff*/)
         {
             Player* const botPlayer = itr->second;
             WorldSession* const pBotWorldSession = botPlayer->GetSession();
-            while(!pBotWorldSession->m_recvQueue.empty())
+            std::unique_ptr<WorldPacket> botpacket;
+            while (pBotWorldSession->m_recvQueue.Dequeue(botpacket))
             {
-                auto const botpacket = std::move(pBotWorldSession->m_recvQueue.front());
-                pBotWorldSession->m_recvQueue.pop_front();
-
                 OpcodeHandler const& opHandle = opcodeTable[botpacket->GetOpcode()];
                 pBotWorldSession->ExecuteOpcode(opHandle, *botpacket);
             }
@@ -490,7 +477,6 @@ bool WorldSession::Update(uint32 /*diff*/)
         {
             if (m_requestSocket)
             {
-                std::lock_guard<std::mutex> guard(m_recvQueueLock);
                 if (!IsOffline())
                     SetOffline();
 
@@ -580,10 +566,24 @@ void WorldSession::UpdateMap(uint32 diff)
             m_timeSyncTimer -= diff;
     }
 
+    size_t deletedBefore = m_movementPacketsDeletedBefore.load(std::memory_order_acquire);
     std::deque<std::unique_ptr<WorldPacket>> recvQueueMapCopy;
+    for (std::unique_ptr<WorldPacket> packet; m_recvQueueMap.Dequeue(packet);)
     {
-        std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-        std::swap(recvQueueMapCopy, m_recvQueueMap);
+        // queued before a teleport finished, see DeleteMovementPackets
+        if (m_recvQueueMap.DequeuedCount() <= deletedBefore)
+        {
+            switch (packet->GetOpcode())
+            {
+                case MSG_MOVE_SET_FACING:
+                case MSG_MOVE_HEARTBEAT:
+                    continue;
+                default:
+                    break;
+            }
+        }
+
+        recvQueueMapCopy.push_back(std::move(packet));
     }
 
     while (m_socket && !m_socket->IsClosed() && recvQueueMapCopy.size())
@@ -603,13 +603,12 @@ void WorldSession::UpdateMap(uint32 diff)
 #ifdef ENABLE_PLAYERBOTS
 void WorldSession::HandleBotPackets()
 {
-    while (!m_recvQueue.empty())
+    std::unique_ptr<WorldPacket> packet;
+    while (m_recvQueue.Dequeue(packet))
     {
         if (_player)
             _player->SetCanDelayTeleport(true);
 
-        auto const packet = std::move(m_recvQueue.front());
-        m_recvQueue.pop_front();
         OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
         (this->*opHandle.handler)(*packet);
 
@@ -776,10 +775,8 @@ void WorldSession::LogoutPlayer()
         // GM ticket notification
         sTicketMgr.OnPlayerOnlineState(*_player, false);
 
-#if defined(BUILD_DEPRECATED_PLAYERBOT) || defined(ENABLE_PLAYERBOTS)
         // Remember player GUID for update SQL below
         uint32 guid = _player->GetGUIDLow();
-#endif
 
         ///- Remove the player from the world
         // the player may not be in the world when logging out
@@ -805,6 +802,8 @@ void WorldSession::LogoutPlayer()
 
         static SqlStatementID updChars;
 
+        // must run after the logout save of this character, which is queued by its guid
+        CharacterDatabase.BeginTransaction(guid);
 #if defined(BUILD_DEPRECATED_PLAYERBOT) || defined(ENABLE_PLAYERBOTS)
         // Set for only character instead of account id
         // Different characters can be alive as bots
@@ -816,6 +815,7 @@ void WorldSession::LogoutPlayer()
         SqlStatement stmt = CharacterDatabase.CreateStatement(updChars, "UPDATE characters SET online = 0 WHERE account = ?");
         stmt.PExecute(GetAccountId());
 #endif
+        CharacterDatabase.CommitTransaction();
 
         DEBUG_LOG("SESSION: Sent SMSG_LOGOUT_COMPLETE Message");
     }
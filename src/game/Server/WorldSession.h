@@ -31,6 +31,7 @@
 #include "Entities/Item.h"
 #include "WorldSocket.h"
 #include "Multithreading/Messager.h"
+#include "Util/MPSCQueue.h"
 #include "LFG/LFGDefines.h"
 #include "BattleGround/BattleGroundDefines.h"
 
@@ -44,6 +45,7 @@
 
 struct ItemPrototype;
 struct AuctionEntry;
+class AuctionSorter;
 struct AuctionHouseEntry;
 struct DeclinedName;
 struct TradeStatusInfo;
@@ -316,7 +318,8 @@ class WorldSession
         void LogoutPlayer();
         void KickPlayer(bool save = false, bool inPlace = false); // inplace variable needed for shutdown
 
-        void QueuePacket(std::unique_ptr<WorldPacket> new_packet);
+        // false when the packet exceeds the backlog and the session has to be kicked
+        bool QueuePacket(std::unique_ptr<WorldPacket> new_packet);
 
         void DeleteMovementPackets();
 
@@ -389,7 +392,7 @@ class WorldSession
         void SendAuctionRemovedNotification(AuctionEntry* auction) const;
         static void SendAuctionOutbiddedMail(AuctionEntry* auction);
         static void SendAuctionCancelledToBidderMail(AuctionEntry* auction);
-        void BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& searchedname, uint32 listfrom, uint32 levelmin,
+        void BuildListAuctionItems(std::vector<AuctionEntry*>& auctions, AuctionSorter const& sorter, WorldPacket& data, std::wstring const& searchedname, uint32 listfrom, uint32 levelmin,
                                    uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull) const;
 
         AuctionHouseEntry const* GetCheckedAuctionHouseForAuctioneer(ObjectGuid guid) const;
@@ -994,10 +997,11 @@ class WorldSession
         bool m_isRecruiter;
 
         // Thread safety mechanisms
-        std::mutex m_recvQueueLock;
-        std::mutex m_recvQueueMapLock;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueue;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueueMap;
+        // filled by network threads, emptied by the world thread (m_recvQueue) or the player's map thread (m_recvQueueMap)
+        MPSCQueue<std::unique_ptr<WorldPacket>> m_recvQueue;
+        MPSCQueue<std::unique_ptr<WorldPacket>> m_recvQueueMap;
+        // movement packets among the first ones of m_recvQueueMap are skipped by the map thread, set by DeleteMovementPackets
+        std::atomic<size_t> m_movementPacketsDeletedBefore;
 
         Messager<WorldSession> m_messager;
 
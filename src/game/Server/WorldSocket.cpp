@@ -93,8 +93,11 @@ std::deque<uint32> WorldSocket::GetIncOpcodeHistory()
 }
 
 WorldSocket::WorldSocket(boost::asio::io_context& context) : AsyncSocket(context), m_lastPingTime(std::chrono::system_clock::time_point::min()), m_overSpeedPings(0),
-    m_session(nullptr), m_seed(urand()), m_loggingPackets(false)
+    m_session(nullptr), m_seed(urand()), m_loggingPackets(false), m_writeInProgress(false), m_flushScheduled(false), m_flushTimer(context),
+    m_readBuffer(4096), m_readPos(0), m_readEnd(0), m_readHeader(), m_readHeaderValid(false)
 {
+    m_outBuffer.reserve(sWorld.getConfig(CONFIG_UINT32_NETWORK_SEND_BUFFER_SIZE));
+    m_writeBuffer.reserve(sWorld.getConfig(CONFIG_UINT32_NETWORK_SEND_BUFFER_SIZE));
 }
 
 void WorldSocket::SendPacket(const WorldPacket& pct)
@@ -127,21 +130,67 @@ void WorldSocket::SendPacket(const WorldPacket& pct)
     if (m_opcodeHistoryOut.size() > 50)
         m_opcodeHistoryOut.resize(30);
 
+    // append the frame to the pending buffer, it only grows past its reserved size on bursts
+    size_t offset = m_outBuffer.size();
+    m_outBuffer.resize(offset + header.headerSize() + pct.size());
+    std::memcpy(m_outBuffer.data() + offset, header.data(), header.headerSize());
     if (pct.size() > 0)
+        std::memcpy(m_outBuffer.data() + offset + header.headerSize(), pct.contents(), pct.size());
+
+    ScheduleFlush();
+}
+
+void WorldSocket::ScheduleFlush()
+{
+    // pending data is picked up when the write in flight completes
+    if (m_writeInProgress)
+        return;
+
+    uint32 flushInterval = sWorld.getConfig(CONFIG_UINT32_NETWORK_SEND_FLUSH_INTERVAL);
+    if (!flushInterval || m_outBuffer.size() >= sWorld.getConfig(CONFIG_UINT32_NETWORK_SEND_BUFFER_SIZE))
     {
-        // allocate array for full message
-        std::shared_ptr<std::vector<char>> fullMessage = std::make_shared<std::vector<char>>(header.headerSize() + pct.size());
-        std::memcpy(fullMessage->data(), header.data(), header.headerSize()); // copy header
-        std::memcpy((fullMessage->data() + header.headerSize()), reinterpret_cast<const char*>(pct.contents()), pct.size()); // copy packet
-        auto self(shared_from_this());
-        Write(fullMessage->data(), fullMessage->size(), [self, fullMessage](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+        // a timer still scheduled finds the buffer taken and does nothing
+        StartWrite();
+        return;
     }
-    else
+
+    if (m_flushScheduled)
+        return;
+
+    m_flushScheduled = true;
+    m_flushTimer.expires_after(std::chrono::milliseconds(flushInterval));
+    auto self(shared_from_this());
+    m_flushTimer.async_wait([self](const boost::system::error_code& /*error*/)
     {
-        std::shared_ptr<ServerPktHeader> sharedHeader = std::make_shared<ServerPktHeader>(header);
-        auto self(shared_from_this());
-        Write(sharedHeader->data(), sharedHeader->headerSize(), [self, sharedHeader](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
-    }
+        std::lock_guard<std::mutex> guard(self->m_worldSocketMutex);
+        self->m_flushScheduled = false;
+        if (!self->m_writeInProgress && !self->m_outBuffer.empty() && !self->IsClosed())
+            self->StartWrite();
+    });
+}
+
+void WorldSocket::StartWrite()
+{
+    m_writeInProgress = true;
+    std::swap(m_outBuffer, m_writeBuffer);
+
+    auto self(shared_from_this());
+    Write(reinterpret_cast<const char*>(m_writeBuffer.data()), m_writeBuffer.size(), [self](const boost::system::error_code& error, std::size_t /*written*/)
+    {
+        std::lock_guard<std::mutex> guard(self->m_worldSocketMutex);
+        self->m_writeInProgress = false;
+        self->m_writeBuffer.clear();                        // keeps capacity for the next swap
+
+        if (error)
+        {
+            self->m_outBuffer.clear();
+            return;
+        }
+
+        // everything queued during the write goes out in one go
+        if (!self->m_outBuffer.empty())
+            self->StartWrite();
+    });
 }
 
 bool WorldSocket::OnOpen()
@@ -157,10 +206,20 @@ bool WorldSocket::OnOpen()
 
 bool WorldSocket::ProcessIncomingData()
 {
-    std::shared_ptr<ClientPktHeader> header = std::make_shared<ClientPktHeader>();
+    // move the unframed tail to the front, the buffer is only grown when a single packet does not fit
+    if (m_readPos)
+    {
+        std::memmove(m_readBuffer.data(), m_readBuffer.data() + m_readPos, m_readEnd - m_readPos);
+        m_readEnd -= m_readPos;
+        m_readPos = 0;
+    }
+
+    size_t required = sizeof(ClientPktHeader) + (m_readHeaderValid ? m_readHeader.size - 4 : 0);
+    if (m_readBuffer.size() < required)
+        m_readBuffer.resize(required);
 
     auto self(shared_from_this());
-    Read((char*)header.get(), sizeof(ClientPktHeader), [self, header](const boost::system::error_code& error, std::size_t /*read*/) -> void
+    ReadSome(reinterpret_cast<char*>(m_readBuffer.data() + m_readEnd), m_readBuffer.size() - m_readEnd, [self](const boost::system::error_code& error, std::size_t read) -> void
     {
         if (error)
         {
@@ -168,129 +227,150 @@ bool WorldSocket::ProcessIncomingData()
             return;
         }
 
-        // thread safe due to always being called from service context
-        self->m_crypt.DecryptRecv((uint8*)header.get(), sizeof(ClientPktHeader));
-
-        EndianConvertReverse(header->size);
-        EndianConvert(header->cmd);
-
-        if ((header->size < 4) || (header->size > 0x2800) || (header->cmd >= NUM_MSG_TYPES))
+        self->m_readEnd += read;
+        if (!self->ProcessReadBuffer())
         {
-            sLog.outError("WorldSocket::ProcessIncomingData: client sent malformed packet size = %u , cmd = %u", header->size, header->cmd);
+            self->Close();
             return;
         }
 
-        const Opcodes opcode = static_cast<Opcodes>(header->cmd);
+        self->ProcessIncomingData();
+    });
 
-        size_t packetSize = header->size - 4;
-        std::shared_ptr<std::vector<uint8>> packetBuffer = std::make_shared<std::vector<uint8>>(packetSize);
+    return true;
+}
 
-        self->Read(reinterpret_cast<char*>(packetBuffer->data()), packetBuffer->size(), [self, packetBuffer, opcode = opcode](const boost::system::error_code& error, std::size_t /*read*/) -> void
+bool WorldSocket::ProcessReadBuffer()
+{
+    while (true)
+    {
+        if (!m_readHeaderValid)
         {
-            if (error)
-            {
-                self->Close();
-                return;
-            }
+            if (m_readEnd - m_readPos < sizeof(ClientPktHeader))
+                return true;
 
-            std::unique_ptr<WorldPacket> pct = std::make_unique<WorldPacket>(opcode, packetBuffer->size());
-            pct->append(*packetBuffer.get());
-            if (sPacketLog->CanLogPacket() && self->IsLoggingPackets())
-                sPacketLog->LogPacket(*pct, CLIENT_TO_SERVER, self->GetRemoteIpAddress(), self->GetRemotePort());
+            std::memcpy(&m_readHeader, m_readBuffer.data() + m_readPos, sizeof(ClientPktHeader));
+            m_readPos += sizeof(ClientPktHeader);
 
-            sLog.outWorldPacketDump(self->GetRemoteEndpoint().c_str(), pct->GetOpcode(), pct->GetOpcodeName(), *pct, true);
+            // thread safe due to always being called from service context, done once per header as the cipher is a stream
+            m_crypt.DecryptRecv(reinterpret_cast<uint8*>(&m_readHeader), sizeof(ClientPktHeader));
 
-            if (WorldSocket::m_packetCooldowns.size() <= size_t(opcode))
-            {
-                sLog.outError("WorldSocket::ProcessIncomingData: Received opcode beyond range of opcodes: %u", opcode);
-                self->Close();
-                return;
-            }
+            EndianConvertReverse(m_readHeader.size);
+            EndianConvert(m_readHeader.cmd);
 
-            if (WorldSocket::m_packetCooldowns[opcode])
+            if ((m_readHeader.size < 4) || (m_readHeader.size > 0x2800) || (m_readHeader.cmd >= NUM_MSG_TYPES))
             {
-                auto now = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
-                if (now < self->m_lastPacket[opcode]) // packet on cooldown
-                {
-                    self->ProcessIncomingData();
-                    return;
-                }
-                else // start cooldown and allow execution
-                    self->m_lastPacket[opcode] = now + std::chrono::milliseconds(WorldSocket::m_packetCooldowns[opcode]);
+                sLog.outError("WorldSocket::ProcessIncomingData: client sent malformed packet size = %u , cmd = %u", m_readHeader.size, m_readHeader.cmd);
+                return false;
             }
 
-            try
-            {
-                switch (opcode)
+            m_readHeaderValid = true;
+        }
+
+        size_t packetSize = m_readHeader.size - 4;
+        if (m_readEnd - m_readPos < packetSize)
+            return true;
+
+        // body goes straight from the socket buffer into the packet storage
+        std::unique_ptr<WorldPacket> pct = std::make_unique<WorldPacket>(static_cast<Opcodes>(m_readHeader.cmd), packetSize);
+        if (packetSize)
+            pct->append(m_readBuffer.data() + m_readPos, packetSize);
+        m_readPos += packetSize;
+        m_readHeaderValid = false;
+
+        if (!ProcessPacket(std::move(pct)))
+            return false;
+
+        // a packet handler may have closed the socket, nothing after it must be processed
+        if (IsClosed())
+            return false;
+    }
+}
+
+bool WorldSocket::ProcessPacket(std::unique_ptr<WorldPacket> pct)
+{
+    const Opcodes opcode = pct->GetOpcode();
+
+    if (sPacketLog->CanLogPacket() && IsLoggingPackets())
+        sPacketLog->LogPacket(*pct, CLIENT_TO_SERVER, GetRemoteIpAddress(), GetRemotePort());
+
+    sLog.outWorldPacketDump(GetRemoteEndpoint().c_str(), pct->GetOpcode(), pct->GetOpcodeName(), *pct, true);
+
+    if (WorldSocket::m_packetCooldowns.size() <= size_t(opcode))
+    {
+        sLog.outError("WorldSocket::ProcessIncomingData: Received opcode beyond range of opcodes: %u", opcode);
+        return false;
+    }
+
+    if (WorldSocket::m_packetCooldowns[opcode])
+    {
+        auto now = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
+        if (now < m_lastPacket[opcode]) // packet on cooldown
+            return true;
+        else // start cooldown and allow execution
+            m_lastPacket[opcode] = now + std::chrono::milliseconds(WorldSocket::m_packetCooldowns[opcode]);
+    }
+
+    try
+    {
+        switch (opcode)
+        {
+            case CMSG_AUTH_SESSION:
+                if (m_session)
                 {
-                    case CMSG_AUTH_SESSION:
-                        if (self->m_session)
-                        {
-                            sLog.outError("WorldSocket::ProcessIncomingData: Player send CMSG_AUTH_SESSION again");
-                            self->Close();
-                            return;
-                        }
-
-                        if (!self->HandleAuthSession(*pct))
-                        {
-                            self->Close();
-                            return;
-                        }
-                        break;
-                    case CMSG_PING:
-                        if (!self->HandlePing(*pct))
-                        {
-                            self->Close();
-                            return;
-                        }
-                        break;
-                    case CMSG_KEEP_ALIVE:
-                        DEBUG_LOG("CMSG_KEEP_ALIVE, size: " SIZEFMTD " ", pct->size());
-                        break;
-                    case CMSG_TIME_SYNC_RESP:
-                        pct->SetReceivedTime(std::chrono::steady_clock::now());
-                        [[fallthrough]];
-                    default:
-                    {
-                        self->m_opcodeHistoryInc.push_front(uint32(pct->GetOpcode()));
-                        if (self->m_opcodeHistoryInc.size() > 50)
-                            self->m_opcodeHistoryInc.resize(30);
-
-                        if (!self->m_session)
-                        {
-                            sLog.outError("WorldSocket::ProcessIncomingData: Client not authed opcode = %u", uint32(opcode));
-                            self->Close();
-                            return;
-                        }
-
-                        self->m_session->QueuePacket(std::move(pct));
-                        break;
-                    }
+                    sLog.outError("WorldSocket::ProcessIncomingData: Player send CMSG_AUTH_SESSION again");
+                    return false;
                 }
-            }
-            catch (ByteBufferException&)
+
+                if (!HandleAuthSession(*pct))
+                    return false;
+                break;
+            case CMSG_PING:
+                if (!HandlePing(*pct))
+                    return false;
+                break;
+            case CMSG_KEEP_ALIVE:
+                DEBUG_LOG("CMSG_KEEP_ALIVE, size: " SIZEFMTD " ", pct->size());
+                break;
+            case CMSG_TIME_SYNC_RESP:
+                pct->SetReceivedTime(std::chrono::steady_clock::now());
+                [[fallthrough]];
+            default:
             {
-                sLog.outError("WorldSocket::ProcessIncomingData ByteBufferException occured while parsing an instant handled packet (opcode: %u) from client %s, accountid=%i.",
-                    opcode, self->GetRemoteAddress().c_str(), self->m_session ? self->m_session->GetAccountId() : -1);
+                m_opcodeHistoryInc.push_front(uint32(pct->GetOpcode()));
+                if (m_opcodeHistoryInc.size() > 50)
+                    m_opcodeHistoryInc.resize(30);
 
-                if (sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
+                if (!m_session)
                 {
-                    DEBUG_LOG("Dumping error-causing packet:");
-                    pct->hexlike();
+                    sLog.outError("WorldSocket::ProcessIncomingData: Client not authed opcode = %u", uint32(opcode));
+                    return false;
                 }
 
-                if (sWorld.getConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET))
-                {
-                    DETAIL_LOG("Disconnecting session [account id %i / address %s] for badly formatted packet.",
-                        self->m_session ? self->m_session->GetAccountId() : -1, self->GetRemoteAddress().c_str());
-                    self->Close();
-                    return;
-                }
+                if (!m_session->QueuePacket(std::move(pct)))
+                    return false;
+                break;
             }
-            self->ProcessIncomingData();
-        });
-    });
+        }
+    }
+    catch (ByteBufferException&)
+    {
+        sLog.outError("WorldSocket::ProcessIncomingData ByteBufferException occured while parsing an instant handled packet (opcode: %u) from client %s, accountid=%i.",
+            opcode, GetRemoteAddress().c_str(), m_session ? m_session->GetAccountId() : -1);
 
+        if (sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
+        {
+            DEBUG_LOG("Dumping error-causing packet:");
+            pct->hexlike();
+        }
+
+        if (sWorld.getConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET))
+        {
+            DETAIL_LOG("Disconnecting session [account id %i / address %s] for badly formatted packet.",
+                m_session ? m_session->GetAccountId() : -1, GetRemoteAddress().c_str());
+            return false;
+        }
+    }
     return true;
 }
 
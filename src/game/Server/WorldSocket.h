@@ -33,6 +33,7 @@
 #include <chrono>
 #include <functional>
 #include <deque>
+#include <vector>
 
 class WorldPacket;
 class WorldSession;
@@ -45,26 +46,22 @@ class WorldSession;
  * Most methods return -1 on failure.
  * The class uses reference counting.
  *
- * For output the class uses one buffer (64K usually) and
- * a queue where it stores packet if there is no place on
- * the queue. The reason this is done, is because the server
- * does really a lot of small-size writes to it, and it doesn't
- * scale well to allocate memory for every. When something is
- * written to the output buffer the socket is not immediately
- * activated for output (again for the same reason), there
- * is 10ms celling (thats why there is Update() override method).
- * This concept is similar to TCP_CORK, but TCP_CORK
- * uses 200ms celling. As result overhead generated by
- * sending packets from "producer" threads is minimal,
- * and doing a lot of writes with small size is tolerated.
+ * For output the class uses two buffers (Network.OutUBuff, 64K usually)
+ * which are allocated once per connection. SendPacket() encrypts the
+ * header and appends the whole frame to the pending buffer, only one
+ * write is in flight at a time and it takes everything queued so far,
+ * the buffers are swapped when it is started. The reason this is done,
+ * is because the server does really a lot of small-size writes to it,
+ * and it doesn't scale well to allocate memory and issue a write for every.
+ * When Network.SendFlushInterval is set the write is not started
+ * immediately, but after that many ms or when the buffer fills up.
+ * This concept is similar to TCP_CORK, but TCP_CORK uses 200ms celling.
  *
- * The calls to Update () method are managed by WorldSocketMgr
- * and ReactorRunnable.
- *
- * For input ,the class uses one 1024 bytes buffer on stack
- * to which it does recv() calls. And then received data is
- * distributed where its needed. 1024 matches pretty well the
- * traffic generated by client for now.
+ * For input ,the class uses one buffer per connection (4K,
+ * grown only for bigger packets) to which it does recv() calls
+ * taking whatever the kernel has. Every complete packet in it is
+ * then decrypted and framed in one pass, the packet body is copied
+ * only once, straight into the WorldPacket given to the session.
  *
  * The input/output do speculative reads/writes (AKA it tries
  * to read all data available in the kernel buffer or tries to
@@ -109,9 +106,22 @@ class WorldSocket : public MaNGOS::AsyncSocket<WorldSocket>
 
         BigNumber m_s;
 
-        /// process one incoming packet.
+        /// Received bytes, [m_readPos, m_readEnd) is not framed yet
+        std::vector<uint8> m_readBuffer;
+        size_t m_readPos;
+        size_t m_readEnd;
+        /// Header of the packet whose body is not fully received yet, already decrypted
+        ClientPktHeader m_readHeader;
+        bool m_readHeaderValid;
+
+        /// read whatever is available and process all complete packets.
         virtual bool ProcessIncomingData() override;
 
+        /// Frames all complete packets of the read buffer, false when the socket has to be closed
+        bool ProcessReadBuffer();
+        /// Handles one framed packet, false when the socket has to be closed
+        bool ProcessPacket(std::unique_ptr<WorldPacket> pct);
+
         /// Called by ProcessIncoming() on CMSG_AUTH_SESSION.
         bool HandleAuthSession(WorldPacket& recvPacket);
 
@@ -125,6 +135,19 @@ class WorldSocket : public MaNGOS::AsyncSocket<WorldSocket>
 
         bool m_loggingPackets;
 
+        /// Frames waiting for the next write, appended by SendPacket()
+        std::vector<uint8> m_outBuffer;
+        /// Frames owned by the write in flight
+        std::vector<uint8> m_writeBuffer;
+        bool m_writeInProgress;
+        bool m_flushScheduled;
+        boost::asio::steady_timer m_flushTimer;
+
+        /// Starts the write of the pending buffer now or once the flush interval passed, m_worldSocketMutex must be held
+        void ScheduleFlush();
+        /// Swaps the buffers and writes everything pending, m_worldSocketMutex must be held
+        void StartWrite();
+
     public:
         WorldSocket(boost::asio::io_context& context);
 
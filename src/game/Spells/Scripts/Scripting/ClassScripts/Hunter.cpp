@@ -61,9 +61,7 @@ struct HuntersMark : public AuraScript
         if (aura->GetEffIndex() != EFFECT_INDEX_0) // increases debuff strength on every hit up to 4th
         {
             int32 basevalue = aura->GetBasePoints();
-            aura->GetModifier()->m_amount += basevalue / 10;
-            if (aura->GetModifier()->m_amount > basevalue * 4)
-                aura->GetModifier()->m_amount = basevalue * 4;
+            aura->SetAmount(std::min(aura->GetAmount() + basevalue / 10, basevalue * 4));
         }
         return SPELL_AURA_PROC_OK;
     }
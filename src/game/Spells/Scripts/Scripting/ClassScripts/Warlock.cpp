@@ -417,7 +417,7 @@ struct SeedOfCorruption : public AuraScript
         }
 
         // Damage counting
-        mod->m_amount -= procData.damage;
+        procData.triggeredByAura->SetAmount(mod->m_amount - procData.damage);
         return SPELL_AURA_PROC_OK;
     }
 };
@@ -0,0 +1,61 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Spells/SpellAuraProcIndex.h"
+#include "Spells/SpellAuras.h"
+#include "Spells/SpellMgr.h"
+
+#include <algorithm>
+
+uint32 SpellAuraProcIndex::GetEventProcFlags(SpellEntry const* spellProto)
+{
+    SpellProcEventEntry const* spellProcEvent = sSpellMgr.GetSpellProcEvent(spellProto->Id);
+    if (spellProcEvent && spellProcEvent->procFlags)
+        return spellProcEvent->procFlags;
+    return spellProto->procFlags;
+}
+
+void SpellAuraProcIndex::Insert(SpellAuraHolder* holder)
+{
+    uint32 procFlags = GetEventProcFlags(holder->GetSpellProto());
+    if (!procFlags)
+        return;
+
+    // sequence grows with every insert, so a new entry goes behind holders of the same spell as in the multimap
+    Entry entry = { holder->GetId(), procFlags, m_sequence++, holder };
+    m_entries.insert(std::upper_bound(m_entries.begin(), m_entries.end(), entry), entry);
+}
+
+void SpellAuraProcIndex::Remove(SpellAuraHolder* holder)
+{
+    auto itr = std::find_if(m_entries.begin(), m_entries.end(), [holder](Entry const& entry) { return entry.holder == holder; });
+    if (itr != m_entries.end())
+        m_entries.erase(itr);
+}
+
+void SpellAuraProcIndex::Clear()
+{
+    m_entries.clear();
+}
+
+void SpellAuraProcIndex::Collect(uint32 procFlags, std::vector<SpellAuraHolder*>& holders) const
+{
+    for (Entry const& entry : m_entries)
+        if (entry.procFlags & procFlags)
+            holders.push_back(entry.holder);
+}
@@ -0,0 +1,73 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SPELLAURAPROCINDEX_H
+#define MANGOS_SPELLAURAPROCINDEX_H
+
+#include "Common.h"
+
+#include <vector>
+
+class SpellAuraHolder;
+struct SpellEntry;
+
+/**
+ * Holders of a unit that are able to proc, kept with their proc flags.
+ *
+ * A holder can only proc from an event sharing at least one proc flag with it, so the
+ * proc system collects candidates by a flag test over the proc capable holders instead of
+ * checking every holder of the unit. Entries are kept in the order of the unit holder map
+ * (spell id, then order of apply), which keeps proc order unchanged. A unit without proc
+ * capable holders only pays for an empty vector.
+ */
+class SpellAuraProcIndex
+{
+    public:
+        SpellAuraProcIndex() : m_sequence(0), m_generation(0) {}
+
+        // proc flags checked against the event: spell_proc_event override or spell flags
+        static uint32 GetEventProcFlags(SpellEntry const* spellProto);
+
+        void Insert(SpellAuraHolder* holder);
+        void Remove(SpellAuraHolder* holder);
+        void Clear();
+
+        // appends holders able to react to procFlags, in holder map order
+        void Collect(uint32 procFlags, std::vector<SpellAuraHolder*>& holders) const;
+
+        // spell_proc_event generation the flags were taken from
+        uint32 GetGeneration() const { return m_generation; }
+        void SetGeneration(uint32 generation) { m_generation = generation; }
+
+    private:
+        struct Entry
+        {
+            uint32 spellId;
+            uint32 procFlags;
+            uint64 sequence;
+            SpellAuraHolder* holder;
+
+            bool operator<(Entry const& other) const { return spellId != other.spellId ? spellId < other.spellId : sequence < other.sequence; }
+        };
+
+        std::vector<Entry> m_entries;
+        uint64 m_sequence;
+        uint32 m_generation;
+};
+
+#endif
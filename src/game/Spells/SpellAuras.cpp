@@ -326,6 +326,76 @@ pAuraHandler AuraHandler[TOTAL_AURAS] =
 
 static AuraType const frozenAuraTypes[] = { SPELL_AURA_MOD_ROOT, SPELL_AURA_MOD_STUN, SPELL_AURA_NONE };
 
+namespace
+{
+    // Freed aura and holder memory, kept per thread for the next allocation of the same size.
+    // Blocks come from the global operator new, so a block may be freed on another thread than allocated.
+    // Arrays are trivially destructible, a cache is never accessed after its thread storage is gone.
+    size_t const AURA_CACHE_SIZES = 8;                      // Aura and its subclasses, SpellAuraHolder
+    uint32 const AURA_CACHE_BLOCKS = 512;
+
+    struct AuraAllocationCache
+    {
+        size_t size;
+        uint32 count;
+        void* blocks[AURA_CACHE_BLOCKS];
+    };
+
+    thread_local AuraAllocationCache auraAllocationCaches[AURA_CACHE_SIZES];
+
+    AuraAllocationCache* GetAuraAllocationCache(size_t size)
+    {
+        for (AuraAllocationCache& cache : auraAllocationCaches)
+        {
+            if (cache.size == size)
+                return &cache;
+            if (!cache.size)
+            {
+                cache.size = size;
+                return &cache;
+            }
+        }
+        return nullptr;
+    }
+
+    void* AllocateAuraMemory(size_t size)
+    {
+        AuraAllocationCache* cache = GetAuraAllocationCache(size);
+        if (cache && cache->count)
+            return cache->blocks[--cache->count];
+        return ::operator new(size);
+    }
+
+    void ReleaseAuraMemory(void* ptr, size_t size)
+    {
+        AuraAllocationCache* cache = GetAuraAllocationCache(size);
+        if (cache && cache->count < AURA_CACHE_BLOCKS)
+            cache->blocks[cache->count++] = ptr;
+        else
+            ::operator delete(ptr);
+    }
+}
+
+void* Aura::operator new(size_t size)
+{
+    return AllocateAuraMemory(size);
+}
+
+void Aura::operator delete(void* ptr, size_t size)
+{
+    ReleaseAuraMemory(ptr, size);
+}
+
+void* SpellAuraHolder::operator new(size_t size)
+{
+    return AllocateAuraMemory(size);
+}
+
+void SpellAuraHolder::operator delete(void* ptr, size_t size)
+{
+    ReleaseAuraMemory(ptr, size);
+}
+
 Aura::Aura(SpellEntry const* spellproto, SpellEffectIndex eff, int32 const* currentDamage, int32 const* currentBasePoints, SpellAuraHolder* holder, Unit* target, Unit* caster, Item* castItem) :
     m_spellmod(nullptr), m_periodicTimer(0), m_periodicTick(0), m_removeMode(AURA_REMOVE_BY_DEFAULT),
     m_effIndex(eff), m_positive(false), m_isPeriodic(false), m_isAreaAura(false),
@@ -503,7 +573,9 @@ void Aura::Update(uint32 diff)
             // update before applying (aura can be removed in TriggerSpell or PeriodicTick calls)
             m_periodicTimer += m_modifier.periodictime;
             ++m_periodicTick;                               // for some infinity auras in some cases can overflow and reset
+            Unit* target = GetTarget();
             PeriodicTick();
+            target->InvalidateAuraAggregates();             // ticks may change amounts of auras
         }
     }
 }
@@ -820,6 +892,26 @@ void Aura::ApplyModifier(bool apply, bool Real)
 
     if (GetSpellProto()->HasAttribute(SPELL_ATTR_EX4_OWNER_POWER_SCALING) && m_removeMode != AURA_REMOVE_BY_GAINED_STACK)
         GetTarget()->RegisterScalingAura(this, apply);
+
+    // handlers may change amounts of any aura of the target
+    GetTarget()->InvalidateAuraAggregates();
+}
+
+void Aura::SetAmount(int32 amount)
+{
+    m_modifier.m_amount = amount;
+    GetTarget()->InvalidateAuraAggregate(m_modifier.m_auraname);
+}
+
+void Aura::SetLoadedState(int32 damage, uint32 periodicTime)
+{
+    m_modifier.m_amount = damage;
+    m_modifier.periodictime = periodicTime;
+
+    if (uint32 maxticks = GetAuraMaxTicks())
+        m_periodicTick = maxticks - GetAuraDuration() / m_modifier.periodictime;
+
+    GetTarget()->InvalidateAuraAggregate(m_modifier.m_auraname);
 }
 
 void Aura::UpdateAuraScaling()
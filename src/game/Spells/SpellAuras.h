@@ -96,6 +96,10 @@ class SpellAuraHolder
     public:
         SpellAuraHolder(SpellEntry const* spellproto, Unit* target, WorldObject* caster, Item* castItem, SpellEntry const* triggeredBy);
         ~SpellAuraHolder();
+
+        // memory is recycled through a per thread cache
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
         Aura* m_auras[MAX_EFFECT_INDEX];
 
         void AddAura(Aura* aura, SpellEffectIndex index);
@@ -444,6 +448,10 @@ class Aura
 
         virtual ~Aura();
 
+        // memory is recycled through a per thread cache, for subclasses too
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         void SetModifier(AuraType type, int32 amount, uint32 periodicTime, int32 miscValue);
         Modifier*       GetModifier()       { return &m_modifier; }
         Modifier const* GetModifier() const { return &m_modifier; }
@@ -460,7 +468,7 @@ class Aura
         SpellEffectIndex GetEffIndex() const { return m_effIndex; }
         int32 GetBasePoints() const { return m_currentBasePoints; }
         int32 GetAmount() const { return m_modifier.m_amount; }
-        void SetAmount(int32 amount) { m_modifier.m_amount = amount; }
+        void SetAmount(int32 amount);
 
         int32 GetAuraMaxDuration() const { return GetHolder()->GetAuraMaxDuration(); }
         int32 GetAuraDuration() const { return GetHolder()->GetAuraDuration(); }
@@ -473,14 +481,7 @@ class Aura
         }
         uint32 GetStackAmount() const { return GetHolder()->GetStackAmount(); }
 
-        void SetLoadedState(int32 damage, uint32 periodicTime)
-        {
-            m_modifier.m_amount = damage;
-            m_modifier.periodictime = periodicTime;
-
-            if (uint32 maxticks = GetAuraMaxTicks())
-                m_periodicTick = maxticks - GetAuraDuration() / m_modifier.periodictime;
-        }
+        void SetLoadedState(int32 damage, uint32 periodicTime);
 
         bool IsPositive() const { return m_positive; }
         bool IsPersistent() const { return m_isPersistent; }
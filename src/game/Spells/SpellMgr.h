@@ -2449,6 +2449,9 @@ class SpellMgr
             return nullptr;
         }
 
+        // increased at each load of spell_proc_event, lets cached proc flags notice a reload
+        uint32 GetSpellProcEventGeneration() const { return mSpellProcEventGeneration; }
+
         // Spell procs from item enchants
         float GetItemEnchantProcChance(uint32 spellid) const
         {
@@ -2731,6 +2734,7 @@ class SpellMgr
         SpellElixirMap     mSpellElixirs;
         SpellThreatMap     mSpellThreatMap;
         SpellProcEventMap  mSpellProcEventMap;
+        uint32             mSpellProcEventGeneration;
         SpellProcItemEnchantMap mSpellProcItemEnchantMap;
         SkillLineAbilityMap mSkillLineAbilityMapBySpellId;
         SkillLineAbilityMap mSkillLineAbilityMapBySkillId;
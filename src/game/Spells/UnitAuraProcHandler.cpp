@@ -496,15 +496,28 @@ void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
 
     ProcTriggeredVector procTriggered;
     std::vector<SpellAuraHolder*> holdersForDeletion;
+
+    // spell_proc_event reloaded, proc flags of holders may have changed
+    if (m_procAuraHolders.GetGeneration() != sSpellMgr.GetSpellProcEventGeneration())
+    {
+        m_procAuraHolders.Clear();
+        for (auto& data : m_spellAuraHolders)
+            m_procAuraHolders.Insert(data.second);
+        m_procAuraHolders.SetGeneration(sSpellMgr.GetSpellProcEventGeneration());
+    }
+
+    // only holders sharing a proc flag with the event can pass IsTriggeredAtSpellProcEvent
+    std::vector<SpellAuraHolder*> candidates;
+    m_procAuraHolders.Collect(execData.procFlags, candidates);
+
     // Fill procTriggered list
-    for (SpellAuraHolderMap::const_iterator itr = GetSpellAuraHolderMap().begin(); itr != GetSpellAuraHolderMap().end(); ++itr)
+    for (SpellAuraHolder* holder : candidates)
     {
-        SpellAuraHolder* holder = itr->second;
         // skip deleted auras (possible at recursive triggered call
         if (holder->GetState() != SPELLAURAHOLDER_STATE_READY || holder->IsDeleted())
             continue;
 
-        ProcTriggeredData procTriggeredData(nullptr, itr->second);
+        ProcTriggeredData procTriggeredData(nullptr, holder);
 
         SpellProcEventTriggerCheck result = IsTriggeredAtSpellProcEvent(execData, holder, procTriggeredData.spellProcEvent, procTriggeredData.canProc);
         if (holder->GetSpellProto()->HasAttribute(SPELL_ATTR_PROC_FAILURE_BURNS_CHARGE) &&
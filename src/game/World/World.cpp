@@ -21,6 +21,7 @@
 */
 
 #include "World/World.h"
+#include "World/WorldLoader.h"
 #include "Database/DatabaseEnv.h"
 #include "Config/Config.h"
 #include "Platform/Define.h"
@@ -483,6 +484,8 @@ void World::LoadConfigSettings(bool reload)
 
     ///- Read other configuration items from the config file
     setConfigMinMax(CONFIG_UINT32_COMPRESSION, "Compression", 1, 1, 9);
+    setConfigMinMax(CONFIG_UINT32_COMPRESSION_LARGE, "Compression.Large", 0, 0, 9);
+    setConfigMin(CONFIG_UINT32_COMPRESSION_LARGE_SIZE, "Compression.Large.Size", 16384, 100);
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
@@ -613,6 +616,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_FOGOFWAR_STEALTH, "Visibility.FogOfWar.Stealth", 0);
     setConfig(CONFIG_UINT32_FOGOFWAR_HEALTH, "Visibility.FogOfWar.Health", 0);
     setConfig(CONFIG_UINT32_FOGOFWAR_STATS, "Visibility.FogOfWar.Stats", 0);
+    setConfig(CONFIG_BOOL_VISIBILITY_INCREMENTAL, "Visibility.Incremental", true);
 
     setConfig(CONFIG_UINT32_MAIL_DELIVERY_DELAY, "MailDeliveryDelay", HOUR);
 
@@ -626,6 +630,9 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_NUM_MAP_THREADS, "MapUpdate.Threads", 3);
+    setConfig(CONFIG_UINT32_STARTUP_LOAD_THREADS, "StartupLoad.Threads", 4);
+    setConfig(CONFIG_UINT32_TERRAIN_PRELOAD_THREADS, "TerrainPreload.Threads", 1);
+    setConfig(CONFIG_UINT32_TERRAIN_PRELOAD_LOOKAHEAD, "TerrainPreload.LookAhead", 10);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_ORANGE, "SkillChance.Orange", 100);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_YELLOW, "SkillChance.Yellow", 75);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_GREEN,  "SkillChance.Green",  25);
@@ -747,6 +754,9 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_OFFHAND_CHECK_AT_TALENTS_RESET, "OffhandCheckAtTalentsReset", false);
 
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET, "Network.KickOnBadPacket", false);
+    setConfigMin(CONFIG_UINT32_NETWORK_SEND_BUFFER_SIZE, "Network.OutUBuff", 65536, 4096);
+    setConfigMinMax(CONFIG_UINT32_NETWORK_SEND_FLUSH_INTERVAL, "Network.SendFlushInterval", 0, 0, 200);
+    setConfigMin(CONFIG_UINT32_SESSION_PACKET_BACKLOG, "Network.PacketBacklog", 256, 16);
 
     setConfig(CONFIG_BOOL_PLAYER_COMMANDS, "PlayerCommands", true);
 
@@ -843,6 +853,9 @@ void World::LoadConfigSettings(bool reload)
         sLog.outString("Using DataDir %s", m_dataPath.c_str());
     }
 
+    setConfig(CONFIG_BOOL_DBC_MEMORY_MAPPED, "DBC.MemoryMapped", true);
+    setConfig(CONFIG_BOOL_MAP_MEMORY_MAPPED, "Maps.MemoryMapped", true);
+
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
@@ -932,454 +945,537 @@ void World::SetInitialWorldSettings()
 
     m_bgQueue.SetNextRatingDiscardUpdate(std::chrono::milliseconds(sWorld.getConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER)));
 
+    ///- Static data is loaded as a dependency graph, loaders not depending on each other may run at the same time
+    WorldLoader loader(getConfig(CONFIG_UINT32_STARTUP_LOAD_THREADS));
+    LootIdSet ids_set;
+
     /// load spell_dbc first! dbc's need them
-    sLog.outString("Loading spell_template...");
-    sObjectMgr.LoadSpellTemplate();
+    loader.Add("DBC", "spell_template", []()
+    {
+        sLog.outString("Loading spell_template...");
+        sObjectMgr.LoadSpellTemplate();
 
-    sLog.outString("Loading spell groups...");
-    sSpellStacker.LoadSpellGroups();
+        sLog.outString("Loading spell groups...");
+        sSpellStacker.LoadSpellGroups();
+    });
 
     // Load before DBCs
-    sLog.outString("Loading faction_store...");
-    sObjectMgr.LoadFactions();
+    loader.Add("DBC", "faction_store", []()
+    {
+        sLog.outString("Loading faction_store...");
+        sObjectMgr.LoadFactions();
+    });
 
     // Load before npc_text, gossip_menu_option, script_texts
-    sLog.outString("Loading broadcast_text...");
-    sObjectMgr.LoadBroadcastText();
+    loader.Add("DBC", "broadcast_text", []()
+    {
+        sLog.outString("Loading broadcast_text...");
+        sObjectMgr.LoadBroadcastText();
+    });
+
+    loader.Add("DBC", "world_safe_locs", [this]()
+    {
+        sLog.outString("Loading world safe locs ...");
+        LoadWorldSafeLocs();
+    });
 
-    sLog.outString("Loading world safe locs ...");
-    LoadWorldSafeLocs();
+    loader.Add("DBC", "script_names", []()
+    {
+        sLog.outString("Loading Script Names...");
+        sScriptDevAIMgr.LoadScriptNames();
+    });
 
     ///- Load the DBC files
-    sLog.outString("Initialize DBC data stores...");
-    LoadDBCStores(m_dataPath);
-    DetectDBCLang();
-    sObjectMgr.SetDbc2StorageLocaleIndex(GetDefaultDbcLocale());    // Get once for all the locale index of DBC language (console/broadcasts)
-
-    if (VMAP::IVMapManager* vmmgr2 = VMAP::VMapFactory::createOrGetVMapManager()) // after map store init
+    loader.Add("DBC", "dbc", [this]()
     {
-        std::vector<uint32> mapIds;
-        for (uint32 mapId = 0; mapId < sMapStore.GetNumRows(); mapId++)
-            if (sMapStore.LookupEntry(mapId))
-                mapIds.push_back(mapId);
+        sLog.outString("Initialize DBC data stores...");
+        LoadDBCStores(m_dataPath, getConfig(CONFIG_BOOL_DBC_MEMORY_MAPPED));
+        DetectDBCLang();
+        sObjectMgr.SetDbc2StorageLocaleIndex(GetDefaultDbcLocale());    // Get once for all the locale index of DBC language (console/broadcasts)
 
-        vmmgr2->InitializeThreadUnsafe(mapIds);
-    }
+        if (VMAP::IVMapManager* vmmgr2 = VMAP::VMapFactory::createOrGetVMapManager()) // after map store init
+        {
+            std::vector<uint32> mapIds;
+            for (uint32 mapId = 0; mapId < sMapStore.GetNumRows(); mapId++)
+                if (sMapStore.LookupEntry(mapId))
+                    mapIds.push_back(mapId);
 
-    // Loading cameras for characters creation cinematic
-    sLog.outString("Loading cinematic...");
-    LoadM2Cameras(m_dataPath);
+            vmmgr2->InitializeThreadUnsafe(mapIds);
+        }
+    }, { "spell_template", "faction_store", "broadcast_text", "world_safe_locs" });
 
-    sLog.outString("Loading Script Names...");
-    sScriptDevAIMgr.LoadScriptNames();
+    // Loading cameras for characters creation cinematic
+    loader.Add("DBC", "cinematic", [this]()
+    {
+        sLog.outString("Loading cinematic...");
+        LoadM2Cameras(m_dataPath);
+    }, { "dbc" });
 
-    sLog.outString("Loading WorldTemplate...");
-    sObjectMgr.LoadWorldTemplate();
+    loader.Add("Templates", "instance_templates", []()
+    {
+        sLog.outString("Loading WorldTemplate...");
+        sObjectMgr.LoadWorldTemplate();
 
-    sLog.outString("Loading InstanceTemplate...");
-    sObjectMgr.LoadInstanceTemplate();
+        sLog.outString("Loading InstanceTemplate...");
+        sObjectMgr.LoadInstanceTemplate();
 
-    sLog.outString("Loading SkillLineAbilityMultiMaps Data...");
-    sSpellMgr.LoadSkillLineAbilityMaps();
+        sLog.outString("Loading SkillLineAbilityMultiMaps Data...");
+        sSpellMgr.LoadSkillLineAbilityMaps();
 
-    sLog.outString("Loading SkillRaceClassInfoMultiMap Data...");
-    sSpellMgr.LoadSkillRaceClassInfoMap();
+        sLog.outString("Loading SkillRaceClassInfoMultiMap Data...");
+        sSpellMgr.LoadSkillRaceClassInfoMap();
+    }, { "dbc", "script_names" });
 
     ///- Clean up and pack instances
-    sLog.outString("Packing instances...");
-    sMapPersistentStateMgr.PackInstances();
+    loader.Add("Templates", "instances", []()
+    {
+        sLog.outString("Packing instances...");
+        sMapPersistentStateMgr.PackInstances();
 
-    sLog.outString("Cleaning up instances...");
-    sMapPersistentStateMgr.CleanupInstances();              // must be called before `creature_respawn`/`gameobject_respawn` tables and after pack instances
+        sLog.outString("Cleaning up instances...");
+        sMapPersistentStateMgr.CleanupInstances();          // must be called before `creature_respawn`/`gameobject_respawn` tables and after pack instances
 
-    sLog.outString("Packing groups...");
-    sObjectMgr.PackGroupIds();                              // must be after CleanupInstances
+        sLog.outString("Packing groups...");
+        sObjectMgr.PackGroupIds();                          // must be after CleanupInstances
 
-    ///- Init highest guids before any guid using table loading to prevent using not initialized guids in some code.
-    sObjectMgr.SetHighestGuids();                           // must be after PackInstances() and PackGroupIds()
-    sLog.outString();
+        ///- Init highest guids before any guid using table loading to prevent using not initialized guids in some code.
+        sObjectMgr.SetHighestGuids();                       // must be after PackInstances() and PackGroupIds()
+        sLog.outString();
+    }, { "instance_templates" });
 
-    sLog.outString("Loading Page Texts...");
-    sObjectMgr.LoadPageTexts();
+    loader.Add("Templates", "object_templates", [this]()
+    {
+        sLog.outString("Loading Page Texts...");
+        sObjectMgr.LoadPageTexts();
 
-    sLog.outString("Loading String Ids...");
-    sScriptMgr.LoadStringIds(); // must be before LoadCreatureSpawnDataTemplates
+        sLog.outString("Loading String Ids...");
+        sScriptMgr.LoadStringIds(); // must be before LoadCreatureSpawnDataTemplates
 
-    sLog.outString("Loading Game Object Templates...");     // must be after LoadPageTexts
-    std::vector<uint32> transportDisplayIds = sObjectMgr.LoadGameobjectInfo();
-    MMAP::MMapFactory::createOrGetMMapManager()->loadAllGameObjectModels(GetDataPath(), transportDisplayIds);
+        sLog.outString("Loading Game Object Templates..."); // must be after LoadPageTexts
+        std::vector<uint32> transportDisplayIds = sObjectMgr.LoadGameobjectInfo();
+        MMAP::MMapFactory::createOrGetMMapManager()->loadAllGameObjectModels(GetDataPath(), transportDisplayIds);
 
-    sLog.outString("Loading GameObject models...");
-    LoadGameObjectModelList();
-    sLog.outString();
+        sLog.outString("Loading GameObject models...");
+        LoadGameObjectModelList();
+        sLog.outString();
 
-    // loads GO data
-    sTransportMgr.LoadTransportAnimationAndRotation();
+        // loads GO data
+        sTransportMgr.LoadTransportAnimationAndRotation();
+    }, { "instance_templates" });
 
-    sLog.outString("Loading Spell Chain Data...");
-    sSpellMgr.LoadSpellChains();
+    loader.Add("Templates", "spell_data", []()
+    {
+        sLog.outString("Loading Spell Chain Data...");
+        sSpellMgr.LoadSpellChains();
 
-    sLog.outString("Checking Spell Cone Data...");
-    sObjectMgr.CheckSpellCones();
+        sLog.outString("Checking Spell Cone Data...");
+        sObjectMgr.CheckSpellCones();
 
-    sLog.outString("Loading Spell Elixir types...");
-    sSpellMgr.LoadSpellElixirs();
+        sLog.outString("Loading Spell Elixir types...");
+        sSpellMgr.LoadSpellElixirs();
 
-    sLog.outString("Loading Spell Learn Skills...");
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
+        sLog.outString("Loading Spell Learn Skills...");
+        sSpellMgr.LoadSpellLearnSkills();                   // must be after LoadSpellChains
 
-    sLog.outString("Loading Spell Learn Spells...");
-    sSpellMgr.LoadSpellLearnSpells();
+        sLog.outString("Loading Spell Learn Spells...");
+        sSpellMgr.LoadSpellLearnSpells();
 
-    sLog.outString("Loading Spell Proc Event conditions...");
-    sSpellMgr.LoadSpellProcEvents();
+        sLog.outString("Loading Spell Proc Event conditions...");
+        sSpellMgr.LoadSpellProcEvents();
 
-    sLog.outString("Loading Spell Proc Item Enchant...");
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
+        sLog.outString("Loading Spell Proc Item Enchant...");
+        sSpellMgr.LoadSpellProcItemEnchant();               // must be after LoadSpellChains
 
-    sLog.outString("Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
+        sLog.outString("Loading Aggro Spells Definitions...");
+        sSpellMgr.LoadSpellThreats();
+    }, { "instance_templates" });
 
-    sLog.outString("Loading NPC Texts...");
-    sObjectMgr.LoadGossipText();
+    loader.Add("Templates", "item_templates", []()
+    {
+        sLog.outString("Loading NPC Texts...");
+        sObjectMgr.LoadGossipText();
 
-    sLog.outString("Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+        sLog.outString("Loading Item Random Enchantments Table...");
+        LoadRandomEnchantmentsTable();
 
-    sLog.outString("Loading Item Templates...");            // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr.LoadItemPrototypes();
+        sLog.outString("Loading Item Templates...");        // must be after LoadRandomEnchantmentsTable and LoadPageTexts
+        sObjectMgr.LoadItemPrototypes();
 
-    sLog.outString("Loading Item Texts...");
-    sObjectMgr.LoadItemTexts();
+        sLog.outString("Loading Item Texts...");
+        sObjectMgr.LoadItemTexts();
+    }, { "object_templates" });
 
-    sLog.outString("Loading Creature Model Based Info Data...");
-    sObjectMgr.LoadCreatureModelInfo();
+    loader.Add("Templates", "creature_templates", []()
+    {
+        sLog.outString("Loading Creature Model Based Info Data...");
+        sObjectMgr.LoadCreatureModelInfo();
 
-    sLog.outString("Loading Equipment templates...");
-    sObjectMgr.LoadEquipmentTemplates();
+        sLog.outString("Loading Equipment templates...");
+        sObjectMgr.LoadEquipmentTemplates();
 
-    sLog.outString("Loading Creature Stats...");
-    sObjectMgr.LoadCreatureClassLvlStats();
+        sLog.outString("Loading Creature Stats...");
+        sObjectMgr.LoadCreatureClassLvlStats();
 
-    sLog.outString("Loading Creature templates...");
-    sObjectMgr.LoadCreatureTemplates();
+        sLog.outString("Loading Creature templates...");
+        sObjectMgr.LoadCreatureTemplates();
 
-    sLog.outString("Loading Creature immunities...");
-    sObjectMgr.LoadCreatureImmunities();
+        sLog.outString("Loading Creature immunities...");
+        sObjectMgr.LoadCreatureImmunities();
 
-    sLog.outString("Loading Combat Conditions, Unit Conditions and Worldstate Expressions...");
-    sObjectMgr.LoadConditionsAndExpressions();
+        sLog.outString("Loading Combat Conditions, Unit Conditions and Worldstate Expressions...");
+        sObjectMgr.LoadConditionsAndExpressions();
 
-    sLog.outString("Loading Creature spell lists...");
-    auto spellLists = sObjectMgr.LoadCreatureSpellLists();
+        sLog.outString("Loading Creature spell lists...");
+        auto spellLists = sObjectMgr.LoadCreatureSpellLists();
 
-    sLog.outString("Loading Creature cooldowns...");
-    sObjectMgr.LoadCreatureCooldowns();
+        sLog.outString("Loading Creature cooldowns...");
+        sObjectMgr.LoadCreatureCooldowns();
 
-    sLog.outString("Loading Creature template spells...");
-    sObjectMgr.LoadCreatureTemplateSpells(spellLists);
+        sLog.outString("Loading Creature template spells...");
+        sObjectMgr.LoadCreatureTemplateSpells(spellLists);
 
-    sLog.outString("Loading Creature Model for race...");   // must be after creature templates
-    sObjectMgr.LoadCreatureModelRace();
+        sLog.outString("Loading Creature Model for race..."); // must be after creature templates
+        sObjectMgr.LoadCreatureModelRace();
 
-    sLog.outString("Loading ItemRequiredTarget...");
-    sObjectMgr.LoadItemRequiredTarget();
+        sLog.outString("Loading ItemRequiredTarget...");
+        sObjectMgr.LoadItemRequiredTarget();
 
-    sLog.outString("Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
+        sLog.outString("Loading Reputation Reward Rates...");
+        sObjectMgr.LoadReputationRewardRate();
 
-    sLog.outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr.LoadReputationOnKill();
+        sLog.outString("Loading Creature Reputation OnKill Data...");
+        sObjectMgr.LoadReputationOnKill();
 
-    sLog.outString("Loading Reputation Spillover Data...");
-    sObjectMgr.LoadReputationSpilloverTemplate();
+        sLog.outString("Loading Reputation Spillover Data...");
+        sObjectMgr.LoadReputationSpilloverTemplate();
 
-    sLog.outString("Loading Points Of Interest Data...");
-    sObjectMgr.LoadPointsOfInterest();
+        sLog.outString("Loading Points Of Interest Data...");
+        sObjectMgr.LoadPointsOfInterest();
 
-    sLog.outString("Loading Pet Create Spells...");
-    sObjectMgr.LoadPetCreateSpells();
+        sLog.outString("Loading Pet Create Spells...");
+        sObjectMgr.LoadPetCreateSpells();
+    }, { "item_templates", "spell_data" });
 
-    sLog.outString("Loading Creature Conditional Spawn Data...");  // must be after LoadCreatureTemplates and before LoadCreatures
-    sObjectMgr.LoadCreatureConditionalSpawn();
+    loader.Add("Spawns", "spawns", [this]()
+    {
+        sLog.outString("Loading Creature Conditional Spawn Data..."); // must be after LoadCreatureTemplates and before LoadCreatures
+        sObjectMgr.LoadCreatureConditionalSpawn();
 
-    sLog.outString("Loading Creature Spawn Template Data..."); // must be before LoadCreatures
-    sObjectMgr.LoadCreatureSpawnDataTemplates();
+        sLog.outString("Loading Creature Spawn Template Data..."); // must be before LoadCreatures
+        sObjectMgr.LoadCreatureSpawnDataTemplates();
 
-    sLog.outString("Loading Creature Spawn Entry Data..."); // must be before LoadCreatures
-    sObjectMgr.LoadCreatureSpawnEntry();
+        sLog.outString("Loading Creature Spawn Entry Data..."); // must be before LoadCreatures
+        sObjectMgr.LoadCreatureSpawnEntry();
 
-    sLog.outString("Loading Creature Data...");
-    sObjectMgr.LoadCreatures();
+        sLog.outString("Loading Creature Data...");
+        sObjectMgr.LoadCreatures();
 
-    sLog.outString("Loading Gameobject Spawn Entry Data..."); // must be before LoadGameObjects
-    sObjectMgr.LoadGameObjectSpawnEntry();
+        sLog.outString("Loading Gameobject Spawn Entry Data..."); // must be before LoadGameObjects
+        sObjectMgr.LoadGameObjectSpawnEntry();
 
-    sLog.outString("Loading Gameobject Data...");
-    sObjectMgr.LoadGameObjects();
+        sLog.outString("Loading Gameobject Data...");
+        sObjectMgr.LoadGameObjects();
 
-    if (getConfig(CONFIG_BOOL_REGEN_ZONE_AREA_ON_STARTUP))
-    {
-        sLog.outString("Generating zone and area ids for creatures and gameobjects...");
-        sObjectMgr.GenerateZoneAndAreaIds();
-    }
+        if (getConfig(CONFIG_BOOL_REGEN_ZONE_AREA_ON_STARTUP))
+        {
+            sLog.outString("Generating zone and area ids for creatures and gameobjects...");
+            sObjectMgr.GenerateZoneAndAreaIds();
+        }
 
-    sLog.outString("Loading SpellsScriptTarget...");
-    sSpellMgr.LoadSpellScriptTarget();                      // must be after LoadCreatureTemplates, LoadCreatures and LoadGameobjectInfo
+        sLog.outString("Loading SpellsScriptTarget...");
+        sSpellMgr.LoadSpellScriptTarget();                  // must be after LoadCreatureTemplates, LoadCreatures and LoadGameobjectInfo
 
-    sLog.outString("Generating SpellTargetMgr data...\n");
-    SpellTargetMgr::Initialize(); // must be after LoadSpellScriptTarget
+        sLog.outString("Generating SpellTargetMgr data...\n");
+        SpellTargetMgr::Initialize(); // must be after LoadSpellScriptTarget
 
-    sLog.outString("Loading Creature Addon Data...");
-    sObjectMgr.LoadCreatureAddons();                        // must be after LoadCreatureTemplates() and LoadCreatures()
-    sLog.outString(">>> Creature Addon Data loaded");
-    sLog.outString();
+        sLog.outString("Loading Creature Addon Data...");
+        sObjectMgr.LoadCreatureAddons();                    // must be after LoadCreatureTemplates() and LoadCreatures()
+        sLog.outString(">>> Creature Addon Data loaded");
+        sLog.outString();
 
-    sLog.outString("Loading Gameobject Template Addon Data...");
-    sObjectMgr.LoadGameObjectTemplateAddons();
+        sLog.outString("Loading Gameobject Template Addon Data...");
+        sObjectMgr.LoadGameObjectTemplateAddons();
 
-    sLog.outString("Loading CreatureLinking Data...");      // must be after Creatures
-    sCreatureLinkingMgr.LoadFromDB();
+        sLog.outString("Loading CreatureLinking Data...");  // must be after Creatures
+        sCreatureLinkingMgr.LoadFromDB();
+    }, { "creature_templates", "instances" });
 
-    sLog.outString("Loading Objects Pooling Data...");
-    sPoolMgr.LoadFromDB();
+    loader.Add("Pools, events and scripts", "pools_and_events", []()
+    {
+        sLog.outString("Loading Objects Pooling Data...");
+        sPoolMgr.LoadFromDB();
 
-    sLog.outString("Loading Weather Data...");
-    sWeatherMgr.LoadWeatherZoneChances();
+        sLog.outString("Loading Weather Data...");
+        sWeatherMgr.LoadWeatherZoneChances();
 
-    sLog.outString("Loading Quests...");
-    sObjectMgr.LoadQuests();                                // must be loaded after DBCs, creature_template, item_template, gameobject tables
+        sLog.outString("Loading Quests...");
+        sObjectMgr.LoadQuests();                            // must be loaded after DBCs, creature_template, item_template, gameobject tables
 
-    sLog.outString("Loading Quests Relations...");
-    sObjectMgr.LoadQuestRelations();                        // must be after quest load
-    sLog.outString(">>> Quests Relations loaded");
-    sLog.outString();
+        sLog.outString("Loading Quests Relations...");
+        sObjectMgr.LoadQuestRelations();                    // must be after quest load
+        sLog.outString(">>> Quests Relations loaded");
+        sLog.outString();
 
-    sLog.outString("Loading Game Event Data...");           // must be after sPoolMgr.LoadFromDB and quests to properly load pool events and quests for events
-    sGameEventMgr.LoadFromDB();
-    sLog.outString(">>> Game Event Data loaded");
-    sLog.outString();
+        sLog.outString("Loading Game Event Data...");       // must be after sPoolMgr.LoadFromDB and quests to properly load pool events and quests for events
+        sGameEventMgr.LoadFromDB();
+        sLog.outString(">>> Game Event Data loaded");
+        sLog.outString();
 
-    sLog.outString("Loading Dungeon Encounters...");
-    sObjectMgr.LoadDungeonEncounters();                     // Load DungeonEncounter.dbc from DB
+        sLog.outString("Loading Dungeon Encounters...");
+        sObjectMgr.LoadDungeonEncounters();                 // Load DungeonEncounter.dbc from DB
 
-    sLog.outString("Loading WorldState Names...");          // must be before conditions and dbscripts
-    sObjectMgr.LoadWorldStateNames();
+        sLog.outString("Loading WorldState Names...");      // must be before conditions and dbscripts
+        sObjectMgr.LoadWorldStateNames();
 
-    sLog.outString("Loading Conditions...");                // Load Conditions
-    sObjectMgr.LoadConditions();
+        sLog.outString("Loading Conditions...");            // Load Conditions
+        sObjectMgr.LoadConditions();
+    }, { "spawns" });
 
-    sLog.outString("Loading Spawn Groups");                 // must be after creature and GO load
-    sObjectMgr.LoadSpawnGroups();
+    loader.Add("Pools, events and scripts", "world_maps", []()
+    {
+        sLog.outString("Loading Spawn Groups");             // must be after creature and GO load
+        sObjectMgr.LoadSpawnGroups();
 
-    // Not sure if this can be moved up in the sequence (with static data loading) as it uses MapManager
-    sLog.outString("Loading Transports...");
-    sMapMgr.LoadTransports();
+        // Not sure if this can be moved up in the sequence (with static data loading) as it uses MapManager
+        sLog.outString("Loading Transports...");
+        sMapMgr.LoadTransports();
 
-    sLog.outString("Creating map persistent states for non-instanceable maps...");     // must be after PackInstances(), LoadCreatures(), sPoolMgr.LoadFromDB(), sGameEventMgr.LoadFromDB();
-    sMapPersistentStateMgr.InitWorldMaps();
-    sLog.outString();
+        sLog.outString("Creating map persistent states for non-instanceable maps...");     // must be after PackInstances(), LoadCreatures(), sPoolMgr.LoadFromDB(), sGameEventMgr.LoadFromDB();
+        sMapPersistentStateMgr.InitWorldMaps();
+        sLog.outString();
 
-    sLog.outString("Loading Creature Respawn Data...");     // must be after LoadCreatures(), and sMapPersistentStateMgr.InitWorldMaps()
-    sMapPersistentStateMgr.LoadCreatureRespawnTimes();
+        sLog.outString("Loading Creature Respawn Data..."); // must be after LoadCreatures(), and sMapPersistentStateMgr.InitWorldMaps()
+        sMapPersistentStateMgr.LoadCreatureRespawnTimes();
 
-    sLog.outString("Loading Gameobject Respawn Data...");   // must be after LoadGameObjects(), and sMapPersistentStateMgr.InitWorldMaps()
-    sMapPersistentStateMgr.LoadGameobjectRespawnTimes();
+        sLog.outString("Loading Gameobject Respawn Data..."); // must be after LoadGameObjects(), and sMapPersistentStateMgr.InitWorldMaps()
+        sMapPersistentStateMgr.LoadGameobjectRespawnTimes();
+    }, { "pools_and_events" });
 
-    sLog.outString("Loading SpellArea Data...");            // must be after quest load
-    sSpellMgr.LoadSpellAreas();
+    loader.Add("Pools, events and scripts", "area_data", [this]()
+    {
+        sLog.outString("Loading SpellArea Data...");        // must be after quest load
+        sSpellMgr.LoadSpellAreas();
 
-    sLog.outString("Loading AreaTrigger definitions...");
-    sObjectMgr.LoadAreaTriggerTeleports();                  // must be after item template load
+        sLog.outString("Loading AreaTrigger definitions...");
+        sObjectMgr.LoadAreaTriggerTeleports();              // must be after item template load
 
-    sLog.outString("Loading Quest Area Triggers...");
-    sObjectMgr.LoadQuestAreaTriggers();                     // must be after LoadQuests
+        sLog.outString("Loading Quest Area Triggers...");
+        sObjectMgr.LoadQuestAreaTriggers();                 // must be after LoadQuests
 
-    sLog.outString("Loading Tavern Area Triggers...");
-    sObjectMgr.LoadTavernAreaTriggers();
+        sLog.outString("Loading Tavern Area Triggers...");
+        sObjectMgr.LoadTavernAreaTriggers();
 
-    sLog.outString("Loading AreaTrigger script names...");
-    sScriptDevAIMgr.LoadAreaTriggerScripts();
+        sLog.outString("Loading AreaTrigger script names...");
+        sScriptDevAIMgr.LoadAreaTriggerScripts();
 
-    sLog.outString("Loading event id script names...");
-    sScriptDevAIMgr.LoadEventIdScripts();
+        sLog.outString("Loading event id script names...");
+        sScriptDevAIMgr.LoadEventIdScripts();
 
-    sLog.outString("Loading Graveyard-zone links...");
-    LoadGraveyardZones();
+        sLog.outString("Loading Graveyard-zone links...");
+        LoadGraveyardZones();
 
-    sLog.outString("Loading taxi flight shortcuts...");
-    sObjectMgr.LoadTaxiShortcuts();
+        sLog.outString("Loading taxi flight shortcuts...");
+        sObjectMgr.LoadTaxiShortcuts();
 
-    sLog.outString("Loading spell target destination coordinates...");
-    sSpellMgr.LoadSpellTargetPositions();
+        sLog.outString("Loading spell target destination coordinates...");
+        sSpellMgr.LoadSpellTargetPositions();
 
-    sLog.outString("Loading SpellAffect definitions...");
-    sSpellMgr.LoadSpellAffects();
+        sLog.outString("Loading SpellAffect definitions...");
+        sSpellMgr.LoadSpellAffects();
 
-    sLog.outString("Loading spell pet auras...");
-    sSpellMgr.LoadSpellPetAuras();
+        sLog.outString("Loading spell pet auras...");
+        sSpellMgr.LoadSpellPetAuras();
 
-    sLog.outString("Loading Player Create Info & Level Stats...");
-    sObjectMgr.LoadPlayerInfo();
-    sLog.outString(">>> Player Create Info & Level Stats loaded");
-    sLog.outString();
+        sLog.outString("Loading Player Create Info & Level Stats...");
+        sObjectMgr.LoadPlayerInfo();
+        sLog.outString(">>> Player Create Info & Level Stats loaded");
+        sLog.outString();
 
-    sLog.outString("Loading Exploration BaseXP Data...");
-    sObjectMgr.LoadExplorationBaseXP();
+        sLog.outString("Loading Exploration BaseXP Data...");
+        sObjectMgr.LoadExplorationBaseXP();
 
-    sLog.outString("Loading Pet Name Parts...");
-    sObjectMgr.LoadPetNames();
+        sLog.outString("Loading Pet Name Parts...");
+        sObjectMgr.LoadPetNames();
 
-    CharacterDatabaseCleaner::CleanDatabase();
-    sLog.outString();
+        CharacterDatabaseCleaner::CleanDatabase();
+        sLog.outString();
 
-    sLog.outString("Loading the max pet number...");
-    sObjectMgr.LoadPetNumber();
+        sLog.outString("Loading the max pet number...");
+        sObjectMgr.LoadPetNumber();
+
+        sLog.outString("Loading pet level stats...");
+        sObjectMgr.LoadPetLevelInfo();
+
+        sLog.outString("Loading Player Corpses...");
+        sObjectMgr.LoadCorpses();
+
+        sLog.outString("Loading Player level dependent mail rewards...");
+        sObjectMgr.LoadMailLevelRewards();
+    }, { "world_maps" });
+
+    // every loot store only reads templates and conditions, so they are loaded next to each other
+    loader.Add("Loot", "loot_creature", []() { LoadLootTemplates_Creature(); }, { "pools_and_events" });
+    loader.Add("Loot", "loot_fishing", []() { LoadLootTemplates_Fishing(); }, { "pools_and_events" });
+    loader.Add("Loot", "loot_gameobject", []() { LoadLootTemplates_Gameobject(); }, { "pools_and_events" });
+    loader.Add("Loot", "loot_item", []() { LoadLootTemplates_Item(); }, { "pools_and_events" });
+    loader.Add("Loot", "loot_mail", []() { LoadLootTemplates_Mail(); }, { "pools_and_events" });
+    loader.Add("Loot", "loot_pickpocketing", []() { LoadLootTemplates_Pickpocketing(); }, { "pools_and_events" });
+    loader.Add("Loot", "loot_skinning", []() { LoadLootTemplates_Skinning(); }, { "pools_and_events" });
+    loader.Add("Loot", "loot_disenchant", []() { LoadLootTemplates_Disenchant(); }, { "pools_and_events" });
+    loader.Add("Loot", "loot_prospecting", []() { LoadLootTemplates_Prospecting(); }, { "pools_and_events" });
+    loader.Add("Loot", "loot_reference", [&ids_set]()
+    {
+        LoadLootTemplates_Reference(ids_set);
+        sLog.outString(">>> Loot Tables loaded");
+        sLog.outString();
+    }, { "loot_creature", "loot_fishing", "loot_gameobject", "loot_item", "loot_mail", "loot_pickpocketing", "loot_skinning", "loot_disenchant", "loot_prospecting" });
+
+    loader.Add("Loot", "skill_tables", []()
+    {
+        sLog.outString("Loading Skill Discovery Table...");
+        LoadSkillDiscoveryTable();
+
+        sLog.outString("Loading Skill Extra Item Table...");
+        LoadSkillExtraItemTable();
+    }, { "creature_templates" });
+
+    loader.Add("Pools, events and scripts", "db_scripts", []()
+    {
+        sLog.outString("Loading Skill Fishing base level requirements...");
+        sObjectMgr.LoadFishingBaseSkillLevel();
+
+        sLog.outString("Loading Instance encounters data..."); // must be after Creature loading
+        sObjectMgr.LoadInstanceEncounters();
+
+        sLog.outString("Loading Npc Text Id...");
+        sObjectMgr.LoadNpcGossips();                        // must be after load Creature and LoadGossipText
+
+        sLog.outString("Loading Scripts random templates..."); // must be before String calls
+        sScriptMgr.LoadDbScriptRandomTemplates();
+        ///- Load and initialize DBScripts Engine
+        sLog.outString("Loading DB-Scripts Engine...");
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_RELAY);                // must be first in dbscripts loading
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GOSSIP);               // must be before gossip menu options
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_QUEST_START);          // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_QUEST_END);            // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_SPELL);                // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GAMEOBJECT);           // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GAMEOBJECT_TEMPLATE);  // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_EVENT);                // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_CREATURE_DEATH);       // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadScriptMap(SCRIPT_TYPE_CREATURE_MOVEMENT);    // before loading from creature_movement
+        sObjectMgr.LoadAreatriggerLocales();
+        sLog.outString(">>> Scripts loaded");
+        sLog.outString();
 
-    sLog.outString("Loading pet level stats...");
-    sObjectMgr.LoadPetLevelInfo();
+        sLog.outString("Loading Scripts text locales...");  // must be after Load*Scripts calls
+        sScriptMgr.LoadDbScriptStrings();
 
-    sLog.outString("Loading Player Corpses...");
-    sObjectMgr.LoadCorpses();
+        sLog.outString("Loading Gossip Menus...");
+        sObjectMgr.LoadGossipMenus();
 
-    sLog.outString("Loading Player level dependent mail rewards...");
-    sObjectMgr.LoadMailLevelRewards();
+        sLog.outString("Loading Vendors...");
+        sObjectMgr.LoadVendorTemplates();                   // must be after load ItemTemplate
+        sObjectMgr.LoadVendors();                           // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
 
-    sLog.outString("Loading Loot Tables...");
-    LootIdSet ids_set;
-    LoadLootTables(ids_set);
-    sLog.outString(">>> Loot Tables loaded");
-    sLog.outString();
+        sLog.outString("Loading Trainers...");
+        sObjectMgr.LoadTrainerTemplates();                  // must be after load CreatureTemplate
+        sObjectMgr.LoadTrainers();                          // must be after load CreatureTemplate, TrainerTemplate
 
-    sLog.outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    sLog.outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    sLog.outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr.LoadFishingBaseSkillLevel();
-
-    sLog.outString("Loading Instance encounters data...");  // must be after Creature loading
-    sObjectMgr.LoadInstanceEncounters();
-
-    sLog.outString("Loading Npc Text Id...");
-    sObjectMgr.LoadNpcGossips();                            // must be after load Creature and LoadGossipText
-
-    sLog.outString("Loading Scripts random templates...");  // must be before String calls
-    sScriptMgr.LoadDbScriptRandomTemplates();
-    ///- Load and initialize DBScripts Engine
-    sLog.outString("Loading DB-Scripts Engine...");
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_RELAY);                // must be first in dbscripts loading
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GOSSIP);               // must be before gossip menu options
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_QUEST_START);          // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_QUEST_END);            // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_SPELL);                // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GAMEOBJECT);           // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_GAMEOBJECT_TEMPLATE);  // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_EVENT);                // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_CREATURE_DEATH);       // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadScriptMap(SCRIPT_TYPE_CREATURE_MOVEMENT);    // before loading from creature_movement
-    sObjectMgr.LoadAreatriggerLocales();
-    sLog.outString(">>> Scripts loaded");
-    sLog.outString();
+        sLog.outString("Loading Waypoint scripts...");
 
-    sLog.outString("Loading Scripts text locales...");      // must be after Load*Scripts calls
-    sScriptMgr.LoadDbScriptStrings();
+        sLog.outString("Loading Waypoints...");
+        sWaypointMgr.Load();
 
-    sLog.outString("Loading Gossip Menus...");
-    sObjectMgr.LoadGossipMenus();
+        sLog.outString("Loading ReservedNames...");
+        sObjectMgr.LoadReservedPlayersNames();
+    }, { "area_data" });
 
-    sLog.outString("Loading Vendors...");
-    sObjectMgr.LoadVendorTemplates();                       // must be after load ItemTemplate
-    sObjectMgr.LoadVendors();                               // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
+    loader.Add("Pools, events and scripts", "quest_gameobjects", []()
+    {
+        sLog.outString("Loading GameObjects for quests...");
+        sObjectMgr.LoadGameObjectForQuests();               // must be after loot tables
+    }, { "db_scripts", "loot_reference" });
 
-    sLog.outString("Loading Trainers...");
-    sObjectMgr.LoadTrainerTemplates();                      // must be after load CreatureTemplate
-    sObjectMgr.LoadTrainers();                              // must be after load CreatureTemplate, TrainerTemplate
+    loader.Add("Pools, events and scripts", "scripts", []()
+    {
+        sLog.outString("Loading BattleMasters...");
+        sBattleGroundMgr.LoadBattleMastersEntry(false);
 
-    sLog.outString("Loading Waypoint scripts...");
+        sLog.outString("Loading BattleGround event indexes...");
+        sBattleGroundMgr.LoadBattleEventIndexes(false);
 
-    sLog.outString("Loading Waypoints...");
-    sWaypointMgr.Load();
+        sLog.outString("Loading GameTeleports...");
+        sObjectMgr.LoadGameTele();
 
-    sLog.outString("Loading ReservedNames...");
-    sObjectMgr.LoadReservedPlayersNames();
+        sLog.outString("Loading Questgiver Greetings...");
+        sObjectMgr.LoadQuestgiverGreeting();
 
-    sLog.outString("Loading GameObjects for quests...");
-    sObjectMgr.LoadGameObjectForQuests();
+        sLog.outString("Loading Trainer Greetings...");
+        sObjectMgr.LoadTrainerGreetings();
 
-    sLog.outString("Loading BattleMasters...");
-    sBattleGroundMgr.LoadBattleMastersEntry(false);
+        ///- Loading localization data
+        sLog.outString("Loading Localization strings...");
+        sObjectMgr.LoadCreatureLocales();                   // must be after CreatureInfo loading
+        sObjectMgr.LoadGameObjectLocales();                 // must be after GameobjectInfo loading
+        sObjectMgr.LoadItemLocales();                       // must be after ItemPrototypes loading
+        sObjectMgr.LoadQuestLocales();                      // must be after QuestTemplates loading
+        sObjectMgr.LoadGossipTextLocales();                 // must be after LoadGossipText
+        sObjectMgr.LoadPageTextLocales();                   // must be after PageText loading
+        sObjectMgr.LoadGossipMenuItemsLocales();            // must be after gossip menu items loading
+        sObjectMgr.LoadPointOfInterestLocales();            // must be after POI loading
+        sObjectMgr.LoadQuestgiverGreetingLocales();
+        sObjectMgr.LoadTrainerGreetingLocales();            // must be after CreatureInfo loading
+        sObjectMgr.LoadBroadcastTextLocales();
+        sLog.outString(">>> Localization strings loaded");
+        sLog.outString();
 
-    sLog.outString("Loading BattleGround event indexes...");
-    sBattleGroundMgr.LoadBattleEventIndexes(false);
+        ///- Load and initialize EventAI Scripts
+        sLog.outString("Loading CreatureEventAI Summons...");
+        sEventAIMgr.LoadCreatureEventAI_Summons(false);     // false, will checked in LoadCreatureEventAI_Scripts
 
-    sLog.outString("Loading GameTeleports...");
-    sObjectMgr.LoadGameTele();
+        sLog.outString("Loading CreatureEventAI Scripts...");
+        sEventAIMgr.LoadCreatureEventAI_Scripts();
 
-    sLog.outString("Loading Questgiver Greetings...");
-    sObjectMgr.LoadQuestgiverGreeting();
+        ///- Load and initialize scripting library
+        sLog.outString("Initializing Scripting Library...");
+        sScriptDevAIMgr.Initialize();
+        sLog.outString();
 
-    sLog.outString("Loading Trainer Greetings...");
-    sObjectMgr.LoadTrainerGreetings();
+        // after SD2
+        sLog.outString("Loading spell scripts...");
+        SpellScriptMgr::LoadScripts();
 
-    ///- Loading localization data
-    sLog.outString("Loading Localization strings...");
-    sObjectMgr.LoadCreatureLocales();                       // must be after CreatureInfo loading
-    sObjectMgr.LoadGameObjectLocales();                     // must be after GameobjectInfo loading
-    sObjectMgr.LoadItemLocales();                           // must be after ItemPrototypes loading
-    sObjectMgr.LoadQuestLocales();                          // must be after QuestTemplates loading
-    sObjectMgr.LoadGossipTextLocales();                     // must be after LoadGossipText
-    sObjectMgr.LoadPageTextLocales();                       // must be after PageText loading
-    sObjectMgr.LoadGossipMenuItemsLocales();                // must be after gossip menu items loading
-    sObjectMgr.LoadPointOfInterestLocales();                // must be after POI loading
-    sObjectMgr.LoadQuestgiverGreetingLocales();
-    sObjectMgr.LoadTrainerGreetingLocales();                // must be after CreatureInfo loading
-    sObjectMgr.LoadBroadcastTextLocales();
-    sLog.outString(">>> Localization strings loaded");
-    sLog.outString();
+        // after spellscripts
+        sScriptDevAIMgr.CheckScriptNames();
+    }, { "quest_gameobjects" });
 
     ///- Load dynamic data tables from the database
-    sLog.outString("Loading Auctions...");
-    sAuctionMgr.LoadAuctionItems();
-    sAuctionMgr.LoadAuctions();
-    sLog.outString(">>> Auctions loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Guilds...");
-    sGuildMgr.LoadGuilds();
-
-    sLog.outString("Loading ArenaTeams...");
-    sObjectMgr.LoadArenaTeams();
-
-    sLog.outString("Loading Groups...");
-    sObjectMgr.LoadGroups();
+    loader.Add("Character data", "character_data", []()
+    {
+        sLog.outString("Loading Auctions...");
+        sAuctionMgr.LoadAuctionItems();
+        sAuctionMgr.LoadAuctions();
+        sLog.outString(">>> Auctions loaded");
+        sLog.outString();
 
-    sLog.outString("Returning old mails...");
-    sObjectMgr.ReturnOrDeleteOldMails(false);
+        sLog.outString("Loading Guilds...");
+        sGuildMgr.LoadGuilds();
 
-    sLog.outString("Loading GM tickets...");
-    sTicketMgr.LoadGMTickets();
+        sLog.outString("Loading ArenaTeams...");
+        sObjectMgr.LoadArenaTeams();
 
-    ///- Load and initialize EventAI Scripts
-    sLog.outString("Loading CreatureEventAI Summons...");
-    sEventAIMgr.LoadCreatureEventAI_Summons(false);         // false, will checked in LoadCreatureEventAI_Scripts
+        sLog.outString("Loading Groups...");
+        sObjectMgr.LoadGroups();
 
-    sLog.outString("Loading CreatureEventAI Scripts...");
-    sEventAIMgr.LoadCreatureEventAI_Scripts();
+        sLog.outString("Returning old mails...");
+        sObjectMgr.ReturnOrDeleteOldMails(false);
 
-    ///- Load and initialize scripting library
-    sLog.outString("Initializing Scripting Library...");
-    sScriptDevAIMgr.Initialize();
-    sLog.outString();
+        sLog.outString("Loading GM tickets...");
+        sTicketMgr.LoadGMTickets();
+    }, { "area_data" });
 
-    // after SD2
-    sLog.outString("Loading spell scripts...");
-    SpellScriptMgr::LoadScripts();
-
-    // after spellscripts
-    sScriptDevAIMgr.CheckScriptNames();
+    loader.Run();
 
     ///- Initialize game time and timers
     sLog.outString("Initialize game time and timers");
@@ -1503,6 +1599,8 @@ void World::SetInitialWorldSettings()
     sLog.outString("---------------------------------------");
     sLog.outString();
 
+    loader.PrintStageTimes();
+
     uint32 uStartInterval = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
     sLog.outString("SERVER STARTUP TIME: %i minutes %i seconds", uStartInterval / 60000, (uStartInterval % 60000) / 1000);
     sLog.outString();
@@ -1730,6 +1828,8 @@ void World::Update(uint32 diff)
     {
         m_timers[WUPDATE_METRICS].Reset();
         GeneratePacketMetrics();
+        GenerateDatabaseMetrics();
+        sMapMgr.GenerateMetrics();
     }
 #endif
 
@@ -2745,6 +2845,27 @@ void World::IncrementOpcodeCounter(uint32 opcodeId)
 }
 
 #ifdef BUILD_METRICS
+void World::GenerateDatabaseMetrics()
+{
+    std::pair<char const*, Database*> databases[] =
+    {
+        { "world", &WorldDatabase }, { "character", &CharacterDatabase }, { "login", &LoginDatabase }, { "logs", &LogsDatabase }
+    };
+
+    for (auto& database : databases)
+    {
+        std::vector<SqlDelayThreadStats> stats = database.second->CollectAsyncStats();
+        for (size_t i = 0; i < stats.size(); ++i)
+        {
+            metric::measurement meas("world.metrics.database", { { "database", database.first }, { "connection", std::to_string(i) } });
+            meas.add_field("queued", std::to_string(stats[i].queued));
+            meas.add_field("executed", std::to_string(stats[i].executed));
+            meas.add_field("avg_us", std::to_string(stats[i].averageLatency));
+            meas.add_field("max_us", std::to_string(stats[i].maxLatency));
+        }
+    }
+}
+
 void World::GeneratePacketMetrics()
 {
     for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
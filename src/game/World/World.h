@@ -93,6 +93,8 @@ enum WorldTimers
 enum eConfigUInt32Values
 {
     CONFIG_UINT32_COMPRESSION = 0,
+    CONFIG_UINT32_COMPRESSION_LARGE,
+    CONFIG_UINT32_COMPRESSION_LARGE_SIZE,
     CONFIG_UINT32_INTERVAL_SAVE,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
@@ -143,6 +145,9 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_NUM_MAP_THREADS,
+    CONFIG_UINT32_STARTUP_LOAD_THREADS,
+    CONFIG_UINT32_TERRAIN_PRELOAD_THREADS,
+    CONFIG_UINT32_TERRAIN_PRELOAD_LOOKAHEAD,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
     CONFIG_UINT32_SKILL_CHANCE_ORANGE,
     CONFIG_UINT32_SKILL_CHANCE_YELLOW,
@@ -210,6 +215,9 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL,
     CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL_DIFFERENCE,
     CONFIG_UINT32_SUNSREACH_COUNTER,
+    CONFIG_UINT32_NETWORK_SEND_BUFFER_SIZE,
+    CONFIG_UINT32_NETWORK_SEND_FLUSH_INTERVAL,
+    CONFIG_UINT32_SESSION_PACKET_BACKLOG,
     CONFIG_UINT32_VALUE_COUNT
 };
 
@@ -390,8 +398,11 @@ enum eConfigBoolValues
     CONFIG_BOOL_ALWAYS_SHOW_QUEST_GREETING,
     CONFIG_BOOL_DISABLE_INSTANCE_RELOCATE,
     CONFIG_BOOL_PRELOAD_MMAP_TILES,
+    CONFIG_BOOL_DBC_MEMORY_MAPPED,
+    CONFIG_BOOL_MAP_MEMORY_MAPPED,
     CONFIG_BOOL_LFG_ENABLED,
     CONFIG_BOOL_REGEN_ZONE_AREA_ON_STARTUP,
+    CONFIG_BOOL_VISIBILITY_INCREMENTAL,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -660,6 +671,7 @@ class World
         void ResetMonthlyQuests();
 #ifdef BUILD_METRICS
         void GeneratePacketMetrics(); // thread safe due to atomics
+        void GenerateDatabaseMetrics(); // async queue depth and latency of every database connection
         uint32 GetAverageLatency() const;
 #endif
 
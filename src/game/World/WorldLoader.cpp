@@ -0,0 +1,173 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/WorldLoader.h"
+#include "Database/DatabaseEnv.h"
+#include "Log/Log.h"
+#include "Util/ProgressBar.h"
+#include "Util/Errors.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+void WorldLoader::Add(char const* stage, char const* name, LoadFunction function, std::initializer_list<char const*> dependsOn)
+{
+    size_t index = m_tasks.size();
+
+    size_t stageIndex = 0;
+    while (stageIndex < m_stages.size() && m_stages[stageIndex].name != stage)
+        ++stageIndex;
+    if (stageIndex == m_stages.size())
+        m_stages.push_back({ stage, {} });
+    m_stages[stageIndex].tasks.push_back(index);
+
+    Task task;
+    task.name = name;
+    task.stage = stageIndex;
+    task.function = std::move(function);
+    task.dependencies = 0;
+
+    for (char const* dependency : dependsOn)
+    {
+        auto itr = m_taskIndex.find(dependency);
+        MANGOS_ASSERT(itr != m_taskIndex.end());            // dependencies have to be added first
+        m_tasks[itr->second].dependents.push_back(index);
+        ++task.dependencies;
+    }
+
+    m_tasks.push_back(std::move(task));
+    m_taskIndex[name] = index;
+}
+
+void WorldLoader::Run()
+{
+    // tasks are stored in a valid dependency order, so one thread just runs them as added
+    if (m_threads <= 1 || m_tasks.size() <= 1)
+    {
+        for (Task& task : m_tasks)
+            RunTask(task);
+        return;
+    }
+
+    RunParallel(std::min(m_threads, uint32(m_tasks.size())));
+}
+
+void WorldLoader::RunTask(Task& task)
+{
+    task.start = Clock::now();
+    task.function();
+    task.end = Clock::now();
+}
+
+void WorldLoader::RunParallel(uint32 threads)
+{
+    std::mutex lock;
+    std::condition_variable condition;
+    std::deque<size_t> ready;
+    size_t finished = 0;
+
+    for (size_t i = 0; i < m_tasks.size(); ++i)
+        if (!m_tasks[i].dependencies)
+            ready.push_back(i);
+
+    auto work = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (true)
+        {
+            condition.wait(guard, [&]() { return !ready.empty() || finished == m_tasks.size(); });
+            if (ready.empty())
+                break;
+
+            size_t index = ready.front();
+            ready.pop_front();
+
+            guard.unlock();
+            RunTask(m_tasks[index]);
+            guard.lock();
+
+            ++finished;
+            for (size_t dependent : m_tasks[index].dependents)
+                if (--m_tasks[dependent].dependencies == 0)
+                    ready.push_back(dependent);
+
+            condition.notify_all();
+        }
+    };
+
+    // progress bars of loaders running at the same time would overwrite each other
+    BarGoLink::SetOutputState(false);
+
+    std::vector<std::thread> workers;
+    for (uint32 i = 1; i < threads; ++i)
+    {
+        workers.emplace_back([&work]()
+        {
+            // let thread do safe mySQL requests
+            WorldDatabase.ThreadStart();
+            CharacterDatabase.ThreadStart();
+            LoginDatabase.ThreadStart();
+
+            work();
+
+            WorldDatabase.ThreadEnd();
+            CharacterDatabase.ThreadEnd();
+            LoginDatabase.ThreadEnd();
+        });
+    }
+
+    work();
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    BarGoLink::SetOutputState(true);
+}
+
+void WorldLoader::PrintStageTimes() const
+{
+    typedef std::chrono::milliseconds ms;
+
+    sLog.outString("Startup load times (%u thread(s)):", std::max(m_threads, uint32(1)));
+    for (Stage const& stage : m_stages)
+    {
+        Clock::time_point start = m_tasks[stage.tasks.front()].start;
+        Clock::time_point end = m_tasks[stage.tasks.front()].end;
+        Clock::duration busy = Clock::duration::zero();
+        Task const* slowest = nullptr;
+
+        for (size_t index : stage.tasks)
+        {
+            Task const& task = m_tasks[index];
+            start = std::min(start, task.start);
+            end = std::max(end, task.end);
+            busy += task.end - task.start;
+
+            if (!slowest || task.end - task.start > slowest->end - slowest->start)
+                slowest = &task;
+        }
+
+        sLog.outString("  %-32s %7u ms, %3u loader(s) busy %7u ms, slowest: %s (%u ms)", stage.name.c_str(),
+                       uint32(std::chrono::duration_cast<ms>(end - start).count()), uint32(stage.tasks.size()),
+                       uint32(std::chrono::duration_cast<ms>(busy).count()), slowest->name.c_str(),
+                       uint32(std::chrono::duration_cast<ms>(slowest->end - slowest->start).count()));
+    }
+    sLog.outString();
+}
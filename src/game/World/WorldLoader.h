@@ -0,0 +1,84 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _WORLD_LOADER_H_INCLUDED
+#define _WORLD_LOADER_H_INCLUDED
+
+#include "Platform/Define.h"
+
+#include <chrono>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Dependency graph of the startup loaders.
+ *
+ * Every loader names the loaders it has to wait for. Those must be added before it,
+ * so the order of Add() calls is always a valid sequential load order. With more than
+ * one thread, loaders whose dependencies are done are run concurrently, each worker
+ * thread using its own connections of the database query pools.
+ */
+class WorldLoader
+{
+    public:
+        typedef std::function<void()> LoadFunction;
+
+        explicit WorldLoader(uint32 threads) : m_threads(threads) {}
+        WorldLoader(const WorldLoader&) = delete;
+
+        void Add(char const* stage, char const* name, LoadFunction function, std::initializer_list<char const*> dependsOn = {});
+
+        // runs every added loader, returns once all of them are done
+        void Run();
+
+        // outputs wall clock and summed loader time of every stage
+        void PrintStageTimes() const;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        struct Task
+        {
+            std::string name;
+            size_t stage;
+            LoadFunction function;
+            std::vector<size_t> dependents;
+            uint32 dependencies;
+            Clock::time_point start;
+            Clock::time_point end;
+        };
+
+        struct Stage
+        {
+            std::string name;
+            std::vector<size_t> tasks;
+        };
+
+        void RunTask(Task& task);
+        void RunParallel(uint32 threads);
+
+        uint32 m_threads;
+        std::vector<Task> m_tasks;
+        std::vector<Stage> m_stages;
+        std::map<std::string, size_t> m_taskIndex;
+};
+
+#endif
@@ -62,6 +62,13 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId, int x, int y) = 0;
             virtual void unloadMap(unsigned int pMapId) = 0;
 
+            /**
+            Read the world models of a tile into the model cache without touching the map tree, safe from any thread.
+            The models stay referenced until releaseTileModels is called with the returned names.
+            */
+            virtual bool prefetchTileModels(const char* pBasePath, unsigned int pMapId, int x, int y, std::vector<std::string>& models) = 0;
+            virtual void releaseTileModels(std::vector<std::string> const& models) = 0;
+
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
@@ -308,29 +308,44 @@ namespace VMAP
 
     WorldModel* VMapManager2::acquireModelInstance(const std::string& basepath, const std::string& filename)
     {
-        std::lock_guard<std::mutex> lock(m_vmModelMutex);
-        ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
-        if (model == iLoadedModelFiles.end())
         {
-            WorldModel* worldmodel = new WorldModel();
-            if (!worldmodel->readFile(basepath + filename + ".vmo"))
+            std::lock_guard<std::mutex> lock(m_vmModelMutex);
+            ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
+            if (model != iLoadedModelFiles.end())
             {
-                ERROR_LOG("VMapManager2: could not load '%s%s.vmo'!", basepath.c_str(), filename.c_str());
-                delete worldmodel;
-                return nullptr;
+                model->second.incRefCount();
+                return model->second.getModel();
             }
+        }
 
+        // read without the lock, other threads only wait for the models they need themselves
+        WorldModel* worldmodel = new WorldModel();
+        if (!worldmodel->readFile(basepath + filename + ".vmo"))
+        {
+            ERROR_LOG("VMapManager2: could not load '%s%s.vmo'!", basepath.c_str(), filename.c_str());
+            delete worldmodel;
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_vmModelMutex);
+        ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
+        if (model == iLoadedModelFiles.end())
+        {
             // insert new data
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "VMapManager2: loading file '%s%s'.", basepath.c_str(), filename.c_str());
             model = iLoadedModelFiles.insert(std::pair<std::string, ManagedModel>(filename, ManagedModel())).first;
             model->second.setModel(worldmodel);
         }
+        else
+            delete worldmodel;                              // loaded by another thread meanwhile
+
         model->second.incRefCount();
         return model->second.getModel();
     }
 
     void VMapManager2::releaseModelInstance(const std::string& filename)
     {
+        std::lock_guard<std::mutex> lock(m_vmModelMutex);
         ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
         if (model == iLoadedModelFiles.end())
         {
@@ -344,6 +359,45 @@ namespace VMAP
             iLoadedModelFiles.erase(model);
         }
     }
+
+    //=========================================================
+
+    bool VMapManager2::prefetchTileModels(const char* pBasePath, unsigned int pMapId, int x, int y, std::vector<std::string>& models)
+    {
+        if (!isMapLoadingEnabled())
+            return false;
+
+        std::string basePath = pBasePath;
+        if (basePath.length() > 0 && (basePath[basePath.length() - 1] != '/' && basePath[basePath.length() - 1] != '\\'))
+            basePath.append("/");
+
+        // the map tree is left alone, only the model files of the tile spawns are read
+        FILE* tf = fopen((basePath + StaticMapTree::getTileFileName(pMapId, x, y)).c_str(), "rb");
+        if (!tf)
+            return false;
+
+        char chunk[8];
+        uint32 numSpawns = 0;
+        bool result = readChunk(tf, chunk, VMAP_MAGIC, 8) && fread(&numSpawns, sizeof(uint32), 1, tf) == 1;
+        for (uint32 i = 0; i < numSpawns && result; ++i)
+        {
+            ModelSpawn spawn;
+            uint32 referencedVal;
+            result = ModelSpawn::readFromFile(tf, spawn) && fread(&referencedVal, sizeof(uint32), 1, tf) == 1;
+            if (result && acquireModelInstance(basePath, spawn.name))
+                models.push_back(spawn.name);
+        }
+        fclose(tf);
+
+        return result;
+    }
+
+    void VMapManager2::releaseTileModels(std::vector<std::string> const& models)
+    {
+        for (auto const& model : models)
+            releaseModelInstance(model);
+    }
+
     //=========================================================
 
     bool VMapManager2::existsMap(const char* pBasePath, unsigned int mapId, int x, int y)
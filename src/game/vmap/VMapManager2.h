@@ -111,6 +111,9 @@ namespace VMAP
             WorldModel* acquireModelInstance(const std::string& basepath, const std::string& filename);
             void releaseModelInstance(const std::string& filename);
 
+            bool prefetchTileModels(const char* pBasePath, unsigned int pMapId, int x, int y, std::vector<std::string>& models) override;
+            void releaseTileModels(std::vector<std::string> const& models) override;
+
             // what's the use of this? o.O
             std::string getDirFileName(unsigned int pMapId, int /*x*/, int /*y*/) const override
             {
@@ -0,0 +1,133 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/** \file
+    \ingroup realmd
+*/
+
+#include "Common.h"
+#include "AuthQueryPool.h"
+#include "Database/DatabaseEnv.h"
+#include "Log/Log.h"
+
+extern DatabaseType LoginDatabase;
+
+AuthQueryPool& AuthQueryPool::Instance()
+{
+    static AuthQueryPool authQueryPool;
+    return authQueryPool;
+}
+
+void AuthQueryPool::Initialize(uint32 threadCount, uint32 cacheTTL)
+{
+    m_work = std::make_unique<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>>(m_context.get_executor());
+    for (uint32 i = 0; i < std::max(threadCount, 1u); ++i)
+    {
+        m_threads.emplace_back([this]()
+        {
+            // let thread do safe mySQL requests
+            LoginDatabase.ThreadStart();
+
+            m_context.run();
+
+            LoginDatabase.ThreadEnd();
+        });
+    }
+
+    m_ipBans.SetTTL(std::chrono::seconds(cacheTTL));
+    m_accountBans.SetTTL(std::chrono::seconds(cacheTTL));
+
+    sLog.outString("Login database query threads: %u, ban cache time: %us", threadCount, cacheTTL);
+}
+
+void AuthQueryPool::Stop()
+{
+    if (!m_work)
+        return;
+
+    // queries already posted are still run
+    m_work.reset();
+    for (std::thread& thread : m_threads)
+        thread.join();
+    m_threads.clear();
+}
+
+std::optional<AccountAuthInfo> AuthQueryPool::GetAccount(std::string const& safeLogin)
+{
+    // never cached, password, lock and gm level changes have to be seen by the next login
+    std::optional<AccountAuthInfo> account;
+
+    // No SQL injection (escaped user name)
+    if (auto queryResult = LoginDatabase.PQuery("SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = '%s'", safeLogin.c_str()))
+    {
+        Field* fields = queryResult->Fetch();
+        account = AccountAuthInfo{ fields[0].GetUInt32(), fields[1].GetUInt8() == 1, fields[2].GetCppString(), fields[3].GetUInt8(),
+            fields[4].GetCppString(), fields[5].GetCppString(), fields[6].GetCppString() };
+    }
+
+    return account;
+}
+
+bool AuthQueryPool::IsIpBanned(std::string const& ip)
+{
+    bool banned;
+    if (m_ipBans.Find(ip, banned))
+        return banned;
+
+    // No SQL injection possible (paste the IP address as passed by the socket)
+    std::unique_ptr<QueryResult> queryResult(LoginDatabase.PQuery("SELECT expires_at FROM ip_banned "
+        "WHERE (expires_at = banned_at OR expires_at > " _UNIXTIME_ ") AND ip = '%s'", ip.c_str()));
+
+    if (!queryResult)
+        return false;
+
+    m_ipBans.Store(ip, true);
+    return true;
+}
+
+std::optional<AccountBanInfo> AuthQueryPool::GetAccountBan(uint32 accountId)
+{
+    AccountBanInfo ban;
+    if (m_accountBans.Find(accountId, ban))
+        return ban;
+
+    std::unique_ptr<QueryResult> queryResult(LoginDatabase.PQuery("SELECT banned_at,expires_at FROM account_banned WHERE "
+        "account_id = %u AND active = 1 AND (expires_at > " _UNIXTIME_ " OR expires_at = banned_at)", accountId));
+    if (!queryResult)
+        return std::nullopt;
+
+    ban = AccountBanInfo{ (*queryResult)[0].GetUInt64(), (*queryResult)[1].GetUInt64() };
+    m_accountBans.Store(accountId, ban);
+    return ban;
+}
+
+std::map<uint32, uint8> AuthQueryPool::GetRealmCharacterCounts(uint32 accountId)
+{
+    // all realms at once instead of one query per realm
+    std::map<uint32, uint8> counts;
+    if (auto queryResult = LoginDatabase.PQuery("SELECT realmid, numchars FROM realmcharacters WHERE acctid = '%u'", accountId))
+    {
+        do
+        {
+            Field* fields = queryResult->Fetch();
+            counts[fields[0].GetUInt32()] = fields[1].GetUInt8();
+        }
+        while (queryResult->NextRow());
+    }
+    return counts;
+}
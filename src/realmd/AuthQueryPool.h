@@ -0,0 +1,176 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup realmd
+/// @{
+/// \file
+
+#ifndef _AUTHQUERYPOOL_H
+#define _AUTHQUERYPOOL_H
+
+#include "Common.h"
+
+#include <boost/asio.hpp>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/// Account row used by the logon challenge
+struct AccountAuthInfo
+{
+    uint32 id;
+    bool locked;
+    std::string lockedIp;
+    uint8 gmlevel;
+    std::string v;
+    std::string s;
+    std::string token;
+};
+
+/// Active ban of an account
+struct AccountBanInfo
+{
+    uint64 bannedAt;
+    uint64 expiresAt;
+};
+
+/// Login database lookups remembered for a short time, only found rows are remembered
+template <typename Key, typename Value>
+class TimedQueryCache
+{
+    public:
+        TimedQueryCache() : m_ttl(0) {}
+
+        void SetTTL(std::chrono::seconds ttl) { m_ttl = ttl; }
+
+        // true when key is cached, value is then set
+        bool Find(Key const& key, Value& value)
+        {
+            if (m_ttl.count() == 0)
+                return false;
+
+            std::lock_guard<std::mutex> guard(m_lock);
+            auto itr = m_entries.find(key);
+            if (itr == m_entries.end())
+                return false;
+
+            if (itr->second.expires < std::chrono::steady_clock::now())
+            {
+                m_entries.erase(itr);
+                return false;
+            }
+
+            value = itr->second.value;
+            return true;
+        }
+
+        void Store(Key const& key, Value const& value)
+        {
+            if (m_ttl.count() == 0)
+                return;
+
+            auto now = std::chrono::steady_clock::now();
+            std::lock_guard<std::mutex> guard(m_lock);
+
+            // entries of accounts not seen again are dropped once in a while
+            if (m_entries.size() >= 4096)
+            {
+                for (auto itr = m_entries.begin(); itr != m_entries.end();)
+                {
+                    if (itr->second.expires < now)
+                        itr = m_entries.erase(itr);
+                    else
+                        ++itr;
+                }
+            }
+
+            m_entries[key] = { now + m_ttl, value };
+        }
+
+        void Remove(Key const& key)
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_entries.erase(key);
+        }
+
+    private:
+        struct Entry
+        {
+            std::chrono::steady_clock::time_point expires;
+            Value value;
+        };
+
+        std::chrono::seconds m_ttl;
+        std::mutex m_lock;
+        std::unordered_map<Key, Entry> m_entries;
+};
+
+/**
+ * Runs login database queries of the auth sockets on own threads, so a slow
+ * query does not stall the network threads. The continuation is posted back
+ * to the executor of the socket that requested the query.
+ */
+class AuthQueryPool
+{
+    public:
+        static AuthQueryPool& Instance();
+
+        void Initialize(uint32 threadCount, uint32 cacheTTL);
+        void Stop();
+
+        template <typename Result, typename Executor>
+        void Execute(Executor const& executor, std::function<Result()>&& query, std::function<void(Result&)>&& continuation)
+        {
+            boost::asio::post(m_context, [executor, query = std::move(query), continuation = std::move(continuation)]()
+            {
+                std::shared_ptr<Result> result = std::make_shared<Result>(query());
+                boost::asio::post(executor, [result, continuation]() { continuation(*result); });
+            });
+        }
+
+        // only to be used inside queries run by Execute
+        std::optional<AccountAuthInfo> GetAccount(std::string const& safeLogin);
+        bool IsIpBanned(std::string const& ip);
+        std::optional<AccountBanInfo> GetAccountBan(uint32 accountId);
+        std::map<uint32, uint8> GetRealmCharacterCounts(uint32 accountId);
+
+        // realmd bans by itself on failed logins, those must be seen at once
+        void InvalidateIpBan(std::string const& ip) { m_ipBans.Remove(ip); }
+        void InvalidateAccountBan(uint32 accountId) { m_accountBans.Remove(accountId); }
+
+    private:
+        boost::asio::io_context m_context;
+        std::unique_ptr<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> m_work;
+        std::vector<std::thread> m_threads;
+
+        // only active bans are cached, a new ban must never wait for an entry to expire
+        TimedQueryCache<std::string, bool> m_ipBans;
+        TimedQueryCache<uint32, AccountBanInfo> m_accountBans;
+};
+
+#define sAuthQueryPool AuthQueryPool::Instance()
+
+#endif
+/// @}
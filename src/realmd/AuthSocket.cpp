@@ -28,6 +28,7 @@
 #include "Log/Log.h"
 #include "RealmList.h"
 #include "AuthSocket.h"
+#include "AuthQueryPool.h"
 #include "AuthCodes.h"
 #include "Auth/CryptoHash.h"
 #include "Auth/SRP6.h"
@@ -184,6 +185,21 @@ typedef struct AuthHandler
     bool (AuthSocket::*handler)(void);
 } AuthHandler;
 
+/// Results of the login database queries run for a logon challenge
+struct LogonChallengeLookup
+{
+    bool ipBanned = false;
+    std::optional<AccountAuthInfo> account;
+    std::optional<AccountBanInfo> ban;
+};
+
+/// Results of the login database queries run for a realm list request
+struct RealmListLookup
+{
+    std::optional<AccountAuthInfo> account;
+    std::map<uint32, uint8> characterCounts;
+};
+
 std::array<uint8, 16> VersionChallenge = { { 0xBA, 0xA3, 0x1E, 0x99, 0xA0, 0x0B, 0x21, 0x57, 0xFC, 0x37, 0x3F, 0xB3, 0x69, 0xCD, 0xD2, 0xF1 } };
 const char logonProofUnknownAccount[4] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT, 0, 0 };
 const char logonProofUnknownAccountVanilla[2] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT };
@@ -405,140 +421,148 @@ bool AuthSocket::_HandleLogonChallenge()
             *pkt << uint8(CMD_AUTH_LOGON_CHALLENGE);
             *pkt << uint8(0x00);
 
-            ///- Verify that this IP is not in the ip_banned table
-            // No SQL injection possible (paste the IP address as passed by the socket)
-            std::unique_ptr<QueryResult> ip_banned_result(LoginDatabase.PQuery("SELECT expires_at FROM ip_banned "
-                "WHERE (expires_at = banned_at OR expires_at > " _UNIXTIME_ ") AND ip = '%s'", self->GetRemoteAddress().c_str()));
-
-            if (ip_banned_result)
+            ///- Ban and account lookups run on the login database threads, the reply is built once they are done
+            std::string address = self->GetRemoteAddress();
+            std::string safeLogin = self->_safelogin;
+            sAuthQueryPool.Execute<LogonChallengeLookup>(self->GetAsioSocket().get_executor(), [address, safeLogin]()
             {
-                *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
-                BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", self->GetRemoteAddress().c_str());
-            }
-            else
+                LogonChallengeLookup lookup;
+                lookup.ipBanned = sAuthQueryPool.IsIpBanned(address);
+                if (lookup.ipBanned)
+                    return lookup;
+
+                lookup.account = sAuthQueryPool.GetAccount(safeLogin);
+                if (lookup.account && (!lookup.account->locked || lookup.account->lockedIp == address))
+                    lookup.ban = sAuthQueryPool.GetAccountBan(lookup.account->id);
+                return lookup;
+            },
+            [self, pkt](LogonChallengeLookup& lookup)
             {
-                ///- Get the account details from the account table
-                // No SQL injection (escaped user name)
-                auto queryResult = LoginDatabase.PQuery("SELECT id,locked,lockedIp,gmlevel,v,s,token FROM account WHERE username = '%s'", self->_safelogin.c_str());
-                if (queryResult)
+                if (lookup.ipBanned)
                 {
-                    Field* fields = queryResult->Fetch();
-
-                    ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
-                    bool locked = false;
-                    if (fields[1].GetUInt8() == 1)               // if ip is locked
-                    {
-                        DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", self->_login.c_str(), fields[2].GetString());
-                        DEBUG_LOG("[AuthChallenge] Player address is '%s'", self->GetRemoteAddress().c_str());
-                        if (strcmp(fields[2].GetString(), self->GetRemoteAddress().c_str()))
-                        {
-                            DEBUG_LOG("[AuthChallenge] Account IP differs");
-                            *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
-                            locked = true;
-                        }
-                        else
-                            DEBUG_LOG("[AuthChallenge] Account IP matches");
-                    }
-                    else
-                        DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", self->_login.c_str());
-
-                    std::string databaseV = fields[4].GetCppString();
-                    std::string databaseS = fields[5].GetCppString();
-                    bool broken = false;
-
-                    if (!self->srp.SetVerifier(databaseV.c_str()) || !self->srp.SetSalt(databaseS.c_str()))
+                    *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
+                    BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", self->GetRemoteAddress().c_str());
+                }
+                else
+                {
+                    if (lookup.account)
                     {
-                        *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
-                        DEBUG_LOG("[AuthChallenge] Broken v/s values in database for account %s!", self->_login.c_str());
-                        broken = true;
-                    }
+                        AccountAuthInfo const& account = *lookup.account;
 
-                    if (!locked && !broken)
-                    {
-                        ///- If the account is banned, reject the logon attempt
-                        auto banresult = LoginDatabase.PQuery("SELECT banned_at,expires_at FROM account_banned WHERE "
-                            "account_id = %u AND active = 1 AND (expires_at > " _UNIXTIME_ " OR expires_at = banned_at)", fields[0].GetUInt32());
-                        if (banresult)
+                        ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
+                        bool locked = false;
+                        if (account.locked)               // if ip is locked
                         {
-                            if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
-                            {
-                                *pkt << uint8(AUTH_LOGON_FAILED_BANNED);
-                                BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", self->_login.c_str());
-                            }
-                            else
+                            DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", self->_login.c_str(), account.lockedIp.c_str());
+                            DEBUG_LOG("[AuthChallenge] Player address is '%s'", self->GetRemoteAddress().c_str());
+                            if (strcmp(account.lockedIp.c_str(), self->GetRemoteAddress().c_str()))
                             {
+                                DEBUG_LOG("[AuthChallenge] Account IP differs");
                                 *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
-                                BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", self->_login.c_str());
+                                locked = true;
                             }
+                            else
+                                DEBUG_LOG("[AuthChallenge] Account IP matches");
                         }
                         else
-                        {
-                            DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
-
-                            BigNumber s;
-                            s.SetHexStr(databaseS.c_str());
-
-                            self->srp.CalculateHostPublicEphemeral();
-
-                            ///- Fill the response packet with the result
-                            *pkt << uint8(AUTH_LOGON_SUCCESS);
+                            DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", self->_login.c_str());
 
-                            // B may be calculated < 32B so we force minimal length to 32B
-                            pkt->append(self->srp.GetHostPublicEphemeral().AsByteArray(32));      // 32 bytes
-                            *pkt << uint8(1);
-                            pkt->append(self->srp.GetGeneratorModulo().AsByteArray());
-                            *pkt << uint8(32);
-                            pkt->append(self->srp.GetPrime().AsByteArray(32));
-                            pkt->append(s.AsByteArray());// 32 bytes
-                            pkt->append(VersionChallenge.data(), VersionChallenge.size());
-                            uint8 securityFlags = 0;
+                        std::string const& databaseV = account.v;
+                        std::string const& databaseS = account.s;
+                        bool broken = false;
 
-                            self->_token = fields[6].GetCppString();
-                            if (!self->_token.empty() && self->_build >= 8606) // authenticator was added in 2.4.3
-                                securityFlags = SECURITY_FLAG_AUTHENTICATOR;
-
-                            if (!self->_token.empty() && self->_build <= 6141)
-                                securityFlags = SECURITY_FLAG_PIN;
-
-                            *pkt << uint8(securityFlags);                    // security flags (0x0...0x04)
+                        if (!self->srp.SetVerifier(databaseV.c_str()) || !self->srp.SetSalt(databaseS.c_str()))
+                        {
+                            *pkt << uint8(AUTH_LOGON_FAILED_FAIL_NOACCESS);
+                            DEBUG_LOG("[AuthChallenge] Broken v/s values in database for account %s!", self->_login.c_str());
+                            broken = true;
+                        }
 
-                            if (securityFlags & SECURITY_FLAG_PIN)          // PIN input
+                        if (!locked && !broken)
+                        {
+                            ///- If the account is banned, reject the logon attempt
+                            if (lookup.ban)
                             {
-                                uint32 gridSeedPkt = self->m_gridSeed = static_cast<uint32>(0);
-                                EndianConvert(gridSeedPkt);
-                                self->m_serverSecuritySalt.SetRand(16 * 8); // 16 bytes random
-                                self->m_promptPin = true;
-
-                                *pkt << gridSeedPkt;
-                                pkt->append(self->m_serverSecuritySalt.AsByteArray(16).data(), 16);
+                                if (lookup.ban->bannedAt == lookup.ban->expiresAt)
+                                {
+                                    *pkt << uint8(AUTH_LOGON_FAILED_BANNED);
+                                    BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", self->_login.c_str());
+                                }
+                                else
+                                {
+                                    *pkt << uint8(AUTH_LOGON_FAILED_SUSPENDED);
+                                    BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", self->_login.c_str());
+                                }
                             }
-
-                            if (securityFlags & SECURITY_FLAG_UNK)          // Matrix input
+                            else
                             {
-                                *pkt << uint8(0);
-                                *pkt << uint8(0);
-                                *pkt << uint8(0);
-                                *pkt << uint8(0);
-                                *pkt << uint64(0);
-                            }
+                                DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
 
-                            if (securityFlags & SECURITY_FLAG_AUTHENTICATOR)    // Authenticator input
-                                *pkt << uint8(1);
+                                BigNumber s;
+                                s.SetHexStr(databaseS.c_str());
 
-                            uint8 secLevel = fields[3].GetUInt8();
-                            self->_accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+                                self->srp.CalculateHostPublicEphemeral();
 
-                            ///- All good, await client's proof
-                            self->_status = STATUS_LOGON_PROOF;
+                                ///- Fill the response packet with the result
+                                *pkt << uint8(AUTH_LOGON_SUCCESS);
+
+                                // B may be calculated < 32B so we force minimal length to 32B
+                                pkt->append(self->srp.GetHostPublicEphemeral().AsByteArray(32));      // 32 bytes
+                                *pkt << uint8(1);
+                                pkt->append(self->srp.GetGeneratorModulo().AsByteArray());
+                                *pkt << uint8(32);
+                                pkt->append(self->srp.GetPrime().AsByteArray(32));
+                                pkt->append(s.AsByteArray());// 32 bytes
+                                pkt->append(VersionChallenge.data(), VersionChallenge.size());
+                                uint8 securityFlags = 0;
+
+                                self->_token = account.token;
+                                if (!self->_token.empty() && self->_build >= 8606) // authenticator was added in 2.4.3
+                                    securityFlags = SECURITY_FLAG_AUTHENTICATOR;
+
+                                if (!self->_token.empty() && self->_build <= 6141)
+                                    securityFlags = SECURITY_FLAG_PIN;
+
+                                *pkt << uint8(securityFlags);                    // security flags (0x0...0x04)
+
+                                if (securityFlags & SECURITY_FLAG_PIN)          // PIN input
+                                {
+                                    uint32 gridSeedPkt = self->m_gridSeed = static_cast<uint32>(0);
+                                    EndianConvert(gridSeedPkt);
+                                    self->m_serverSecuritySalt.SetRand(16 * 8); // 16 bytes random
+                                    self->m_promptPin = true;
+
+                                    *pkt << gridSeedPkt;
+                                    pkt->append(self->m_serverSecuritySalt.AsByteArray(16).data(), 16);
+                                }
+
+                                if (securityFlags & SECURITY_FLAG_UNK)          // Matrix input
+                                {
+                                    *pkt << uint8(0);
+                                    *pkt << uint8(0);
+                                    *pkt << uint8(0);
+                                    *pkt << uint8(0);
+                                    *pkt << uint64(0);
+                                }
+
+                                if (securityFlags & SECURITY_FLAG_AUTHENTICATOR)    // Authenticator input
+                                    *pkt << uint8(1);
+
+                                uint8 secLevel = account.gmlevel;
+                                self->_accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+
+                                ///- All good, await client's proof
+                                self->_status = STATUS_LOGON_PROOF;
+                            }
                         }
                     }
+                    else                                                // no account
+                        *pkt << uint8(AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT);
                 }
-                else                                                // no account
-                    *pkt << uint8(AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT);
-            }
 
-            self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
-            self->ProcessIncomingData();
+                self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+                self->ProcessIncomingData();
+            });
         });
     });
 
@@ -676,12 +700,14 @@ bool AuthSocket::_HandleLogonProof()
                             LoginDatabase.PExecute("INSERT INTO account_banned(account_id, banned_at, expires_at, banned_by, reason, active)"
                                 "VALUES ('%u'," _UNIXTIME_ "," _UNIXTIME_ "+'%u','MaNGOS realmd','Failed login autoban',1)",
                                 acc_id, WrongPassBanTime);
+                            sAuthQueryPool.InvalidateAccountBan(acc_id);
                             BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
                                 self->_login.c_str(), WrongPassBanTime, failed_logins);
                         }
                         else
                         {
                             std::string current_ip = self->GetRemoteAddress();
+                            sAuthQueryPool.InvalidateIpBan(current_ip);
                             LoginDatabase.escape_string(current_ip);
                             LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s'," _UNIXTIME_ "," _UNIXTIME_ "+'%u','MaNGOS realmd','Failed login autoban')",
                                 current_ip.c_str(), WrongPassBanTime);
@@ -750,32 +776,41 @@ bool AuthSocket::_HandleReconnectChallenge()
             EndianConvert(body->build);
             self->_build = body->build;
 
-            auto queryResult = LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", self->_safelogin.c_str());
-
-            // Stop if the account is not found
-            if (!queryResult)
+            // session key changes with every logon, so it is never cached
+            std::string safeLogin = self->_safelogin;
+            sAuthQueryPool.Execute<std::optional<std::string>>(self->GetAsioSocket().get_executor(), [safeLogin]()
             {
-                sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", self->_login.c_str());
-                self->Close();
-                return;
-            }
+                std::optional<std::string> sessionKey;
+                if (auto queryResult = LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", safeLogin.c_str()))
+                    sessionKey = queryResult->Fetch()[0].GetCppString();
+                return sessionKey;
+            },
+            [self](std::optional<std::string>& sessionKey)
+            {
+                // Stop if the account is not found
+                if (!sessionKey)
+                {
+                    sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", self->_login.c_str());
+                    self->Close();
+                    return;
+                }
 
-            Field* fields = queryResult->Fetch();
-            self->srp.SetStrongSessionKey(fields[0].GetString());
+                self->srp.SetStrongSessionKey(sessionKey->c_str());
 
-            ///- All good, await client's proof
-            self->_status = STATUS_RECON_PROOF;
+                ///- All good, await client's proof
+                self->_status = STATUS_RECON_PROOF;
 
-            ///- Sending response
-            std::shared_ptr<ByteBuffer> pkt = std::make_shared<ByteBuffer>();
-            *pkt << (uint8)CMD_AUTH_RECONNECT_CHALLENGE;
-            *pkt << (uint8)0x00;
-            self->_reconnectProof.SetRand(16 * 8);
-            pkt->append(self->_reconnectProof.AsByteArray(16));        // 16 bytes random
-            pkt->append(VersionChallenge.data(), VersionChallenge.size());
-            self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+                ///- Sending response
+                std::shared_ptr<ByteBuffer> pkt = std::make_shared<ByteBuffer>();
+                *pkt << (uint8)CMD_AUTH_RECONNECT_CHALLENGE;
+                *pkt << (uint8)0x00;
+                self->_reconnectProof.SetRand(16 * 8);
+                pkt->append(self->_reconnectProof.AsByteArray(16));        // 16 bytes random
+                pkt->append(VersionChallenge.data(), VersionChallenge.size());
+                self->Write((const char*)pkt->contents(), pkt->size(), [self, pkt](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
 
-            self->ProcessIncomingData();
+                self->ProcessIncomingData();
+            });
         });
     });
 
@@ -852,40 +887,46 @@ bool AuthSocket::_HandleRealmList()
             return;
         }
 
-        // Get the user id (else close the connection)
-        // No SQL injection (escaped user name)
-
-        auto queryResult = LoginDatabase.PQuery("SELECT id, gmlevel FROM account WHERE username = '%s'", self->_safelogin.c_str());
-        if (!queryResult)
+        // Get the user id (else close the connection) and the character counts of all realms in one go
+        std::string safeLogin = self->_safelogin;
+        sAuthQueryPool.Execute<RealmListLookup>(self->GetAsioSocket().get_executor(), [safeLogin]()
         {
-            sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", self->_login.c_str());
-            self->Close();
-            return;
-        }
-
-        uint32 id = (*queryResult)[0].GetUInt32();
-        uint8 accountSecurityLevel = (*queryResult)[1].GetUInt8();
+            RealmListLookup lookup;
+            lookup.account = sAuthQueryPool.GetAccount(safeLogin);
+            if (lookup.account)
+                lookup.characterCounts = sAuthQueryPool.GetRealmCharacterCounts(lookup.account->id);
+            return lookup;
+        },
+        [self](RealmListLookup& lookup)
+        {
+            if (!lookup.account)
+            {
+                sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", self->_login.c_str());
+                self->Close();
+                return;
+            }
 
-        ///- Update realm list if need
-        sRealmList.UpdateIfNeed();
+            ///- Update realm list if need
+            sRealmList.UpdateIfNeed();
 
-        ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
-        ByteBuffer pkt;
-        self->LoadRealmlist(pkt, id, accountSecurityLevel);
+            ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
+            ByteBuffer pkt;
+            self->LoadRealmlist(pkt, lookup.characterCounts, lookup.account->gmlevel);
 
-        std::shared_ptr<ByteBuffer> hdr = std::make_shared<ByteBuffer>();
-        *hdr << (uint8)CMD_REALM_LIST;
-        *hdr << (uint16)pkt.size();
-        hdr->append(pkt);
+            std::shared_ptr<ByteBuffer> hdr = std::make_shared<ByteBuffer>();
+            *hdr << (uint8)CMD_REALM_LIST;
+            *hdr << (uint16)pkt.size();
+            hdr->append(pkt);
 
-        self->Write((const char*)hdr->contents(), hdr->size(), [self, hdr](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
-        self->ProcessIncomingData();
+            self->Write((const char*)hdr->contents(), hdr->size(), [self, hdr](const boost::system::error_code& /*error*/, std::size_t /*written*/) {});
+            self->ProcessIncomingData();
+        });
     });
 
     return true;
 }
 
-void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLevel)
+void AuthSocket::LoadRealmlist(ByteBuffer& pkt, std::map<uint32, uint8> const& characterCounts, uint8 securityLevel)
 {
     switch (_build)
     {
@@ -898,17 +939,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLev
 
             for (const auto& i : sRealmList)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                auto queryResult = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (queryResult)
-                {
-                    Field* fields = queryResult->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                }
-                else
-                    AmountOfCharacters = 0;
+                auto countItr = characterCounts.find(i.second.m_ID);
+                uint8 AmountOfCharacters = countItr != characterCounts.end() ? countItr->second : 0;
 
                 bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
 
@@ -964,17 +996,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLev
 
             for (const auto& i : sRealmList)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                auto queryResult = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (queryResult)
-                {
-                    Field* fields = queryResult->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                }
-                else
-                    AmountOfCharacters = 0;
+                auto countItr = characterCounts.find(i.second.m_ID);
+                uint8 AmountOfCharacters = countItr != characterCounts.end() ? countItr->second : 0;
 
                 bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
 
@@ -34,6 +34,7 @@
 #include <boost/asio.hpp>
 
 #include <functional>
+#include <map>
 
 #define HMAC_RES_SIZE 20
 
@@ -50,7 +51,7 @@ class AuthSocket : public MaNGOS::AsyncSocket<AuthSocket>
         bool OnOpen() override;
 
         void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 accountSecurityLevel = 0);
+        void LoadRealmlist(ByteBuffer& pkt, std::map<uint32, uint8> const& characterCounts, uint8 accountSecurityLevel = 0);
         bool VerifyPinData(uint32 pin, const sAuthLogonPinData_C& clientData);
         int32 generateToken(char const* b32key);
 
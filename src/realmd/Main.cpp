@@ -27,6 +27,7 @@
 #include "Config/Config.h"
 #include "Log/Log.h"
 #include "AuthSocket.h"
+#include "AuthQueryPool.h"
 #include "SystemConfig.h"
 #include "revision.h"
 #include "revision_sql.h"
@@ -238,6 +239,10 @@ int main(int argc, char* argv[])
     LoginDatabase.Execute("DELETE FROM ip_banned WHERE expires_at<=" _UNIXTIME_ " AND expires_at<>banned_at");
     LoginDatabase.CommitTransaction();
 
+    // one query thread per synchronous connection keeps every thread busy on its own connection
+    sAuthQueryPool.Initialize(sConfig.GetIntDefault("LoginDatabaseQueryThreads", sConfig.GetIntDefault("LoginDatabaseConnections", 1)),
+                              sConfig.GetIntDefault("LoginDatabaseCacheTime", 0));
+
     uint32 networkThreadCount = sConfig.GetIntDefault("ListenerThreads", 1);
     MaNGOS::AsyncListener<AuthSocket> listener(context,
             sConfig.GetStringDefault("BindIP", "0.0.0.0"),
@@ -325,6 +330,9 @@ int main(int argc, char* argv[])
     for (uint32 i = 0; i < networkThreadCount; ++i)
         threads[i].join();
 
+    // finish queries still running for closed sockets
+    sAuthQueryPool.Stop();
+
     // Wait for the delay thread to exit
     LoginDatabase.HaltDelayThread();
 
@@ -366,9 +374,10 @@ bool StartDB()
         return false;
     }
 
-    sLog.outString("Login Database total connections: %i", 1 + 1);
+    int nConnections = sConfig.GetIntDefault("LoginDatabaseConnections", 1);
+    sLog.outString("Login Database total connections: %i", nConnections + 1);
 
-    if (!LoginDatabase.Initialize(dbstring.c_str()))
+    if (!LoginDatabase.Initialize(dbstring.c_str(), nConnections))
     {
         sLog.outError("Cannot connect to database");
         return false;
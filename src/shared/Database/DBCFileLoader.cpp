@@ -22,16 +22,39 @@
 
 #include "DBCFileLoader.h"
 
+#if PLATFORM != PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 DBCFileLoader::DBCFileLoader()
 {
     data = nullptr;
     fieldsOffset = nullptr;
+    mappedBase = nullptr;
+    mappedSize = 0;
 }
 
-bool DBCFileLoader::Load(const char* filename, const char* fmt)
+bool DBCFileLoader::Load(const char* filename, const char* fmt, bool mapped)
 {
     uint32 header;
-    delete[] data;
+#if PLATFORM != PLATFORM_WINDOWS
+    if (mappedBase)
+    {
+        munmap(mappedBase, mappedSize);
+        mappedBase = nullptr;
+    }
+    else
+#endif
+        delete[] data;
+    data = nullptr;
+
+#if PLATFORM != PLATFORM_WINDOWS
+    if (mapped)
+        return LoadMapped(filename, fmt);
+#endif
 
     FILE* f = fopen(filename, "rb");
     if (!f)
@@ -84,16 +107,7 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
 
     EndianConvert(stringSize);
 
-    fieldsOffset = new uint32[fieldCount];
-    fieldsOffset[0] = 0;
-    for (uint32 i = 1; i < fieldCount; ++i)
-    {
-        fieldsOffset[i] = fieldsOffset[i - 1];
-        if (fmt[i - 1] == 'b' || fmt[i - 1] == 'X')         // byte fields
-            fieldsOffset[i] += 1;
-        else                                                // 4 byte fields (int32/float/strings)
-            fieldsOffset[i] += 4;
-    }
+    InitFieldsOffset(fmt);
 
     data = new unsigned char[recordSize * recordCount + stringSize];
     stringTable = data + recordSize * recordCount;
@@ -108,9 +122,78 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
     return true;
 }
 
+bool DBCFileLoader::LoadMapped(const char* filename, const char* fmt)
+{
+#if PLATFORM != PLATFORM_WINDOWS
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < 5 * 4)
+    {
+        close(fd);
+        return false;
+    }
+
+    // private mapping, pages are shared with every other process mapping the same file until written
+    void* base = mmap(nullptr, fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        return false;
+
+    mappedBase = base;
+    mappedSize = fileStat.st_size;
+
+    uint32 header[5];                                       // 'WDBC', records, fields, record size, string size
+    memcpy(header, base, sizeof(header));
+    for (uint32& value : header)
+        EndianConvert(value);
+
+    if (header[0] != 0x43424457)                            //'WDBC'
+        return false;
+
+    recordCount = header[1];
+    fieldCount = header[2];
+    recordSize = header[3];
+    stringSize = header[4];
+
+    if (sizeof(header) + size_t(recordSize) * recordCount + stringSize > mappedSize)
+        return false;
+
+    InitFieldsOffset(fmt);
+
+    data = static_cast<unsigned char*>(base) + sizeof(header);
+    stringTable = data + recordSize * recordCount;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void DBCFileLoader::InitFieldsOffset(const char* fmt)
+{
+    delete[] fieldsOffset;
+    fieldsOffset = new uint32[fieldCount];
+    fieldsOffset[0] = 0;
+    for (uint32 i = 1; i < fieldCount; ++i)
+    {
+        fieldsOffset[i] = fieldsOffset[i - 1];
+        if (fmt[i - 1] == 'b' || fmt[i - 1] == 'X')         // byte fields
+            fieldsOffset[i] += 1;
+        else                                                // 4 byte fields (int32/float/strings)
+            fieldsOffset[i] += 4;
+    }
+}
+
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
+#if PLATFORM != PLATFORM_WINDOWS
+    if (mappedBase)
+        munmap(mappedBase, mappedSize);
+    else
+#endif
+        delete[] data;
     delete[] fieldsOffset;
 }
 
@@ -178,7 +261,6 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
     this func will generate  entry[rows] data;
     */
 
-    typedef char* ptr;
     if (strlen(format) != fieldCount)
         return nullptr;
 
@@ -186,27 +268,7 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
     int32 i;
     uint32 recordsize = GetFormatRecordSize(format, &i);
 
-    if (i >= 0)
-    {
-        uint32 maxi = 0;
-        // find max index
-        for (uint32 y = 0; y < recordCount; ++y)
-        {
-            uint32 ind = getRecord(y).getUInt(i);
-            if (ind > maxi)
-                maxi = ind;
-        }
-
-        ++maxi;
-        records = maxi;
-        indexTable = new ptr[maxi];
-        memset(indexTable, 0, maxi * sizeof(ptr));
-    }
-    else
-    {
-        records = recordCount;
-        indexTable = new ptr[recordCount];
-    }
+    indexTable = CreateIndexTable(i, records);
 
     char* dataTable = new char[recordCount * recordsize];
 
@@ -259,13 +321,86 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
     return dataTable;
 }
 
-char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
+char** DBCFileLoader::CreateIndexTable(int32 indexPos, uint32& records)
+{
+    typedef char* ptr;
+    ptr* indexTable;
+
+    if (indexPos >= 0)
+    {
+        uint32 maxi = 0;
+        // find max index
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            uint32 ind = getRecord(y).getUInt(indexPos);
+            if (ind > maxi)
+                maxi = ind;
+        }
+
+        ++maxi;
+        records = maxi;
+        indexTable = new ptr[maxi];
+        memset(indexTable, 0, maxi * sizeof(ptr));
+    }
+    else
+    {
+        records = recordCount;
+        indexTable = new ptr[recordCount];
+    }
+
+    return indexTable;
+}
+
+bool DBCFileLoader::HasInMemoryLayout(const char* format) const
+{
+#if MANGOS_ENDIAN == MANGOS_BIG_ENDIAN
+    return false;
+#else
+    if (strlen(format) != fieldCount)
+        return false;
+
+    // strings are pointers in memory and skipped fields are not stored at all
+    for (uint32 x = 0; x < fieldCount; ++x)
+        if (format[x] != FT_INT && format[x] != FT_IND && format[x] != FT_FLOAT && format[x] != FT_BYTE)
+            return false;
+
+    return GetFormatRecordSize(format) == recordSize;
+#endif
+}
+
+bool DBCFileLoader::AutoProduceIndex(const char* format, uint32& records, char**& indexTable)
+{
+    if (!IsMapped() || !HasInMemoryLayout(format))
+        return false;
+
+    int32 i;
+    GetFormatRecordSize(format, &i);
+
+    indexTable = CreateIndexTable(i, records);
+
+    for (uint32 y = 0; y < recordCount; ++y)
+    {
+        char* record = reinterpret_cast<char*>(data + y * recordSize);
+        if (i >= 0)
+            indexTable[getRecord(y).getUInt(i)] = record;
+        else
+            indexTable[y] = record;
+    }
+
+    return true;
+}
+
+char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable, bool copyPool)
 {
     if (strlen(format) != fieldCount)
         return nullptr;
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    char* stringPool = reinterpret_cast<char*>(stringTable);
+    if (copyPool)
+    {
+        stringPool = new char[stringSize];
+        memcpy(stringPool, stringTable, stringSize);
+    }
 
     uint32 offset = 0;
 
@@ -44,7 +44,8 @@ class DBCFileLoader
         DBCFileLoader();
         ~DBCFileLoader();
 
-        bool Load(const char* filename, const char* fmt);
+        // mapped: map the file copy-on-write instead of reading it, records and strings stay valid while the loader lives
+        bool Load(const char* filename, const char* fmt, bool mapped = false);
 
         class Record
         {
@@ -93,10 +94,21 @@ class DBCFileLoader
         uint32 GetCols() const { return fieldCount; }
         uint32 GetOffset(size_t id) const { return (fieldsOffset != nullptr && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() const { return data != nullptr; }
+        bool IsMapped() const { return mappedBase != nullptr; }
         char* AutoProduceData(const char* format, uint32& records, char**& indexTable);
-        char* AutoProduceStrings(const char* format, char* dataTable);
+        // index mapped records directly, only possible when the file layout is the in-memory layout of format
+        bool AutoProduceIndex(const char* format, uint32& records, char**& indexTable);
+        // copyPool false: string fields point into the loader string block instead of a returned copy
+        char* AutoProduceStrings(const char* format, char* dataTable, bool copyPool = true);
         static uint32 GetFormatRecordSize(const char* format, int32* index_pos = nullptr);
     private:
+        bool LoadMapped(const char* filename, const char* fmt);
+        void InitFieldsOffset(const char* fmt);
+        bool HasInMemoryLayout(const char* format) const;
+        char** CreateIndexTable(int32 indexPos, uint32& records);
+
+        void* mappedBase;
+        size_t mappedSize;
 
         uint32 recordSize;
         uint32 recordCount;
@@ -21,10 +21,14 @@
 
 #include "DBCFileLoader.h"
 
+#include <list>
+#include <memory>
+
 template<class T>
 class DBCStorage
 {
         typedef std::list<char*> StringPoolList;
+        typedef std::list<std::unique_ptr<DBCFileLoader> > MappedFileList;
     public:
         explicit DBCStorage(const char* f) : nCount(0), fieldCount(0), fmt(f), indexTable(nullptr), m_dataTable(nullptr) { }
         ~DBCStorage() { Clear(); }
@@ -34,38 +38,65 @@ class DBCStorage
         char const* GetFormat() const { return fmt; }
         uint32 GetFieldCount() const { return fieldCount; }
 
-        bool Load(char const* fn)
+        // mapped: keep the file mapped, records matching the struct layout and all strings are used in place
+        bool Load(char const* fn, bool mapped = false)
         {
-            DBCFileLoader dbc;
+            std::unique_ptr<DBCFileLoader> dbc(new DBCFileLoader);
             // Check if load was sucessful, only then continue
-            if (!dbc.Load(fn, fmt))
+            if (!dbc->Load(fn, fmt, mapped))
                 return false;
 
-            fieldCount = dbc.GetCols();
+            fieldCount = dbc->GetCols();
 
-            // load raw non-string data
-            m_dataTable = (T*)dbc.AutoProduceData(fmt, nCount, (char**&)indexTable);
+            if (dbc->IsMapped())
+            {
+                if (!dbc->AutoProduceIndex(fmt, nCount, (char**&)indexTable))
+                {
+                    // load raw non-string data, strings point into the mapped string block
+                    m_dataTable = (T*)dbc->AutoProduceData(fmt, nCount, (char**&)indexTable);
+                    if (m_dataTable)
+                        dbc->AutoProduceStrings(fmt, (char*)m_dataTable, false);
+                }
+
+                if (indexTable)
+                    m_mappedFileList.push_back(std::move(dbc));
+            }
+            else
+            {
+                // load raw non-string data
+                m_dataTable = (T*)dbc->AutoProduceData(fmt, nCount, (char**&)indexTable);
 
-            // load strings from dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)m_dataTable));
+                // load strings from dbc data
+                m_stringPoolList.push_back(dbc->AutoProduceStrings(fmt, (char*)m_dataTable));
+            }
 
             // error in dbc file at loading if nullptr
             return indexTable != nullptr;
         }
 
-        bool LoadStringsFrom(char const* fn)
+        bool LoadStringsFrom(char const* fn, bool mapped = false)
         {
             // DBC must be already loaded using Load
             if (!indexTable)
                 return false;
 
-            DBCFileLoader dbc;
+            std::unique_ptr<DBCFileLoader> dbc(new DBCFileLoader);
             // Check if load was successful, only then continue
-            if (!dbc.Load(fn, fmt))
+            if (!dbc->Load(fn, fmt, mapped))
                 return false;
 
+            // records used in place have no string fields
+            if (!m_dataTable)
+                return true;
+
             // load strings from another locale dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)m_dataTable));
+            if (dbc->IsMapped())
+            {
+                if (dbc->AutoProduceStrings(fmt, (char*)m_dataTable, false))
+                    m_mappedFileList.push_back(std::move(dbc));
+            }
+            else
+                m_stringPoolList.push_back(dbc->AutoProduceStrings(fmt, (char*)m_dataTable));
 
             return true;
         }
@@ -85,6 +116,7 @@ class DBCStorage
                 delete[] m_stringPoolList.front();
                 m_stringPoolList.pop_front();
             }
+            m_mappedFileList.clear();
             nCount = 0;
         }
 
@@ -98,6 +130,7 @@ class DBCStorage
         T** indexTable;
         T* m_dataTable;
         StringPoolList m_stringPoolList;
+        MappedFileList m_mappedFileList;
 };
 
 #endif
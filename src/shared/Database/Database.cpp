@@ -20,6 +20,7 @@
 #include "Config/Config.h"
 #include "Database/SqlOperations.h"
 
+#include <algorithm>
 #include <ctime>
 #include <iostream>
 #include <fstream>
@@ -91,13 +92,33 @@ bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id)
     return pStmt->execute();
 }
 
+bool SqlConnection::ExecuteStmtBatch(int nIndex, const std::vector<const SqlStmtParameters*>& rows)
+{
+    if (nIndex == -1)
+        return false;
+
+    SqlPreparedStatement* pStmt = GetStmt(nIndex);
+    if (!pStmt->isBatchable() || rows.size() == 1)
+    {
+        for (const SqlStmtParameters* row : rows)
+        {
+            pStmt->bind(*row);
+            if (!pStmt->execute())
+                return false;
+        }
+        return true;
+    }
+
+    return Execute(pStmt->batchRequest(rows).c_str());
+}
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nAsyncConns /*= 1*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -134,10 +155,20 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
         m_pQueryConnections.push_back(pConn);
     }
 
-    // create and initialize connection for async requests
-    m_pAsyncConn = CreateConnection();
-    if (!m_pAsyncConn->Initialize(infoString))
-        return false;
+    // create and initialize connections for async requests
+    nAsyncConns = std::max(MIN_CONNECTION_POOL_SIZE, std::min(nAsyncConns, MAX_CONNECTION_POOL_SIZE));
+    for (int i = 0; i < nAsyncConns; ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pAsyncConnections.push_back(pConn);
+    }
+    m_pAsyncConn = m_pAsyncConnections.front();
 
     m_pResultQueue = new SqlResultQueue;
 
@@ -150,9 +181,12 @@ void Database::StopServer()
     HaltDelayThread();
 
     delete m_pResultQueue;
-    delete m_pAsyncConn;
-
     m_pResultQueue = nullptr;
+
+    for (auto& m_pAsyncConnection : m_pAsyncConnections)
+        delete m_pAsyncConnection;
+
+    m_pAsyncConnections.clear();
     m_pAsyncConn = nullptr;
 
     for (auto& m_pQueryConnection : m_pQueryConnections)
@@ -161,30 +195,48 @@ void Database::StopServer()
     m_pQueryConnections.clear();
 }
 
-SqlDelayThread* Database::CreateDelayThread()
+SqlDelayThread* Database::CreateDelayThread(SqlConnection* conn, bool pingDatabase)
 {
-    assert(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    assert(conn);
+    return new SqlDelayThread(this, conn, pingDatabase);
 }
 
 void Database::InitDelayThread()
 {
-    assert(!m_delayThread);
+    assert(m_delayThreads.empty());
 
-    // New delay thread for delay execute
-    m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
-    m_delayThread = new MaNGOS::Thread(m_threadBody);
+    // New delay thread for delay execute on every async connection, the first one pings all connections
+    for (SqlConnection* conn : m_pAsyncConnections)
+    {
+        SqlDelayThread* threadBody = CreateDelayThread(conn, m_threadBodies.empty());   // will deleted at thread delete
+        m_threadBodies.push_back(threadBody);
+        m_delayThreads.push_back(new MaNGOS::Thread(threadBody));
+    }
 }
 
 void Database::HaltDelayThread()
 {
-    if (!m_threadBody || !m_delayThread) return;
+    if (m_threadBodies.empty() || m_delayThreads.empty()) return;
 
-    m_threadBody->Stop();                                   // Stop event
-    m_delayThread->wait();                                  // Wait for flush to DB
-    delete m_delayThread;                                   // This also deletes m_threadBody
-    m_delayThread = nullptr;
-    m_threadBody = nullptr;
+    for (SqlDelayThread* threadBody : m_threadBodies)
+        threadBody->Stop();                                 // Stop event
+
+    for (MaNGOS::Thread* delayThread : m_delayThreads)
+    {
+        delayThread->wait();                                // Wait for flush to DB
+        delete delayThread;                                 // This also deletes its thread body
+    }
+
+    m_delayThreads.clear();
+    m_threadBodies.clear();
+}
+
+std::vector<SqlDelayThreadStats> Database::CollectAsyncStats()
+{
+    std::vector<SqlDelayThreadStats> stats;
+    for (SqlDelayThread* threadBody : m_threadBodies)
+        stats.push_back(threadBody->CollectStats());
+    return stats;
 }
 
 void Database::ThreadStart()
@@ -229,8 +281,9 @@ void Database::Ping()
 {
     const char* sql = "SELECT 1";
 
+    for (auto& m_pAsyncConnection : m_pAsyncConnections)
     {
-        SqlConnection::Lock guard(m_pAsyncConn);
+        SqlConnection::Lock guard(m_pAsyncConnection);
         guard->Query(sql);
     }
 
@@ -340,7 +393,7 @@ bool Database::Execute(const char* sql)
             return DirectExecute(sql);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPlainRequest(sql));
+        DelayOrdered(new SqlPlainRequest(sql), { 0 });
     }
 
     return true;
@@ -386,7 +439,12 @@ bool Database::DirectPExecute(const char* format, ...)
     return DirectExecute(szQuery);
 }
 
-bool Database::BeginTransaction()
+bool Database::BeginTransaction(uint32 serialKey /*= 0*/)
+{
+    return BeginTransaction({ serialKey });
+}
+
+bool Database::BeginTransaction(std::initializer_list<uint32> serialKeys)
 {
     if (!m_pAsyncConn)
         return false;
@@ -394,7 +452,7 @@ bool Database::BeginTransaction()
     MANGOS_ASSERT(!m_currentTransaction.get());   // if we will get a nested transaction request - we MUST fix code!!!
 
     if (!m_currentTransaction.get())
-        m_currentTransaction.reset(new SqlTransaction);
+        m_currentTransaction.reset(new SqlTransaction(serialKeys));
 
     return m_currentTransaction.get() != nullptr;
 }
@@ -408,11 +466,43 @@ bool Database::CommitTransaction()
     if (!m_allowAsyncTransactions)
         return CommitTransactionDirect();
 
-    // add SqlTransaction to the async queue
-    m_threadBody->Delay(m_currentTransaction.release());
+    // add SqlTransaction to the async queue of its keys
+    SqlTransaction* pTrans = m_currentTransaction.release();
+    DelayOrdered(pTrans, pTrans->GetSerialKeys());
     return true;
 }
 
+void Database::DelayOrdered(SqlOperation* operation, std::vector<uint32> const& serialKeys)
+{
+    // unkeyed requests are not known to touch data of only some keys, so they stay ordered with all of them
+    std::vector<SqlDelayThread*> threads;
+    for (uint32 serialKey : serialKeys)
+    {
+        if (!serialKey)
+        {
+            threads = m_threadBodies;
+            break;
+        }
+
+        if (std::find(threads.begin(), threads.end(), getDelayThread(serialKey)) == threads.end())
+            threads.push_back(getDelayThread(serialKey));
+    }
+
+    if (threads.size() == 1)
+    {
+        threads.front()->Delay(operation);
+        return;
+    }
+
+    // several connections: the first one executes it once the others drained their earlier requests,
+    // fences are queued under one lock so all connections see them in the same order
+    std::shared_ptr<SqlFence> fence = std::make_shared<SqlFence>(uint32(threads.size() - 1));
+    std::lock_guard<std::mutex> guard(m_fenceMutex);
+    for (size_t i = 1; i < threads.size(); ++i)
+        threads[i]->Delay(new SqlFenceWait(fence));
+    threads.front()->Delay(new SqlFencedOperation(fence, operation));
+}
+
 bool Database::CommitTransactionDirect()
 {
     if (!m_pAsyncConn)
@@ -563,7 +653,7 @@ bool Database::ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params)
             return DirectExecuteStmt(id, params);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPreparedRequest(id.ID(), params));
+        DelayOrdered(new SqlPreparedRequest(id.ID(), params), { 0 });
     }
 
     return true;
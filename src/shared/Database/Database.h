@@ -28,7 +28,9 @@
 
 #include <boost/thread/tss.hpp>
 #include <atomic>
+#include <initializer_list>
 #include <memory>
+#include <mutex>
 
 class SqlTransaction;
 class SqlResultQueue;
@@ -49,6 +51,8 @@ class SqlConnection
         virtual bool Initialize(const char* infoString) = 0;
         // public methods for making queries
         virtual std::unique_ptr<QueryResult> Query(const char* sql) = 0;
+        // same rows with numeric columns decoded once, where the DBMS supports a binary protocol
+        virtual std::unique_ptr<QueryResult> QueryBinary(const char* sql) { return Query(sql); }
         virtual QueryNamedResult* QueryNamed(const char* sql) = 0;
 
         // public methods for making requests
@@ -65,6 +69,8 @@ class SqlConnection
 
         // methods to work with prepared statements
         bool ExecuteStmt(int nIndex, const SqlStmtParameters& id);
+        // several executions of one statement, INSERT/REPLACE are sent as a single multi row request
+        bool ExecuteStmtBatch(int nIndex, const std::vector<const SqlStmtParameters*>& rows);
 
         // SqlConnection object lock
         class Lock
@@ -106,10 +112,10 @@ class Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char* infoString, int nConns = 1);
-        // start worker thread for async DB request execution
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nAsyncConns = 1);
+        // start worker threads for async DB request execution
         virtual void InitDelayThread();
-        // stop worker thread
+        // stop worker threads
         virtual void HaltDelayThread();
 
         /// Synchronous DB queries
@@ -119,6 +125,13 @@ class Database
             return guard->Query(sql);
         }
 
+        // for big loads, see SqlConnection::QueryBinary
+        inline std::unique_ptr<QueryResult> QueryBinary(const char* sql)
+        {
+            SqlConnection::Lock guard(getQueryConnection());
+            return guard->QueryBinary(sql);
+        }
+
         inline QueryNamedResult* QueryNamed(const char* sql)
         {
             SqlConnection::Lock guard(getQueryConnection());
@@ -174,10 +187,10 @@ class Database
         template<typename ParamType1, typename ParamType2, typename ParamType3>
         bool AsyncPQuery(void (*method)(QueryResult*, ParamType1, ParamType2, ParamType3), ParamType1 param1, ParamType2 param2, ParamType3 param3, const char* format, ...) ATTR_PRINTF(6, 7);
         template<class Class>
-        // QueryHolder
-        bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*), SqlQueryHolder* holder);
+        // QueryHolder, serialKey as in BeginTransaction
+        bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*), SqlQueryHolder* holder, uint32 serialKey = 0);
         template<class Class, typename ParamType1>
-        bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*, ParamType1), SqlQueryHolder* holder, ParamType1 param1);
+        bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*, ParamType1), SqlQueryHolder* holder, ParamType1 param1, uint32 serialKey = 0);
 
         bool Execute(const char* sql);
         bool PExecute(const char* format, ...) ATTR_PRINTF(2, 3);
@@ -185,7 +198,11 @@ class Database
         // Writes SQL commands to a LOG file (see mangosd.conf "LogSQL")
         bool PExecuteLog(const char* format, ...) ATTR_PRINTF(2, 3);
 
-        bool BeginTransaction();
+        // transactions with the same serialKey (e.g. a character guid) keep their order, others may run on other async connections
+        // 0 is the key of all async writes not given one, those are ordered with the requests of every key
+        bool BeginTransaction(uint32 serialKey = 0);
+        // transaction ordered with the requests of every given key, e.g. the characters of a trade
+        bool BeginTransaction(std::initializer_list<uint32> serialKeys);
         bool CommitTransaction();
         bool RollbackTransaction();
         // for sync transaction execution
@@ -217,6 +234,9 @@ class Database
         // function to ping database connections
         void Ping();
 
+        // one entry per async connection, see SqlDelayThread::CollectStats
+        std::vector<SqlDelayThreadStats> CollectAsyncStats();
+
         // set this to allow async transactions
         // you should call it explicitly after your server successfully started up
         // NO ASYNC TRANSACTIONS DURING SERVER STARTUP - ONLY DURING RUNTIME!!!
@@ -225,7 +245,7 @@ class Database
     protected:
         Database() :
             m_nQueryConnPoolSize(1), m_pAsyncConn(nullptr), m_pResultQueue(nullptr),
-            m_threadBody(nullptr), m_delayThread(nullptr), m_allowAsyncTransactions(false),
+            m_allowAsyncTransactions(false),
             m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
         {
             m_nQueryCounter = -1;
@@ -236,7 +256,7 @@ class Database
         // factory method to create SqlConnection objects
         virtual SqlConnection* CreateConnection() = 0;
         // factory method to create SqlDelayThread objects
-        virtual SqlDelayThread* CreateDelayThread();
+        virtual SqlDelayThread* CreateDelayThread(SqlConnection* conn, bool pingDatabase);
 
         // per-thread based storage for SqlTransaction object initialization - no locking is required
         boost::thread_specific_ptr<SqlTransaction> m_currentTransaction;
@@ -245,8 +265,12 @@ class Database
 
         // round-robin connection selection
         SqlConnection* getQueryConnection();
-        // for now return one single connection for async requests
+        // connection used by direct executes
         SqlConnection* getAsyncConnection() const { return m_pAsyncConn; }
+        // async requests of one key always go to the same connection
+        SqlDelayThread* getDelayThread(uint32 serialKey) const { return m_threadBodies[serialKey % m_threadBodies.size()]; }
+        // queues a write on the connections of its keys, ordered with the earlier requests of all of them
+        void DelayOrdered(SqlOperation* operation, std::vector<uint32> const& serialKeys);
 
         friend class SqlStatement;
         // PREPARED STATEMENT API
@@ -262,12 +286,15 @@ class Database
         typedef std::vector< SqlConnection* > SqlConnectionContainer;
         SqlConnectionContainer m_pQueryConnections;
 
-        // only one single DB connection for transactions
+        // connections for transactions and async queries, each with its own delay thread
+        SqlConnectionContainer m_pAsyncConnections;
+        // first of them, also used for direct executes
         SqlConnection* m_pAsyncConn;
 
         SqlResultQueue*     m_pResultQueue;                 ///< Transaction queues from diff. threads
-        SqlDelayThread*     m_threadBody;                   ///< Pointer to delay sql executer (owned by m_delayThread)
-        MaNGOS::Thread*     m_delayThread;                  ///< Pointer to executer thread
+        std::vector<SqlDelayThread*> m_threadBodies;        ///< Delay sql executers (owned by m_delayThreads)
+        std::vector<MaNGOS::Thread*> m_delayThreads;        ///< Executer threads, one per async connection
+        std::mutex m_fenceMutex;                            ///< Keeps fences of several connections in one order
 
         std::atomic<bool> m_allowAsyncTransactions;         ///< flag which specifies if async transactions are enabled
 
@@ -221,6 +221,64 @@ std::unique_ptr<QueryResult> MySQLConnection::Query(const char* sql)
     return queryResult;
 }
 
+std::unique_ptr<QueryResult> MySQLConnection::QueryBinary(const char* sql)
+{
+    if (!mMysql)
+        return nullptr;
+
+    uint32 _s = WorldTimer::getMSTime();
+
+    MYSQL_STMT* stmt = mysql_stmt_init(mMysql);
+    if (!stmt)
+    {
+        sLog.outError("SQL: mysql_stmt_init() failed ");
+        return nullptr;
+    }
+
+    if (mysql_stmt_prepare(stmt, sql, strlen(sql)))
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("query ERROR: %s", mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+        return nullptr;
+    }
+
+    MYSQL_RES* metadata = mysql_stmt_result_metadata(stmt);
+    if (!metadata)
+    {
+        mysql_stmt_close(stmt);
+        return nullptr;
+    }
+
+    // string buffers are sized from the longest value of each column
+    bool updateMaxLength = true;
+    mysql_stmt_attr_set(stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength);
+
+    if (mysql_stmt_execute(stmt) || mysql_stmt_store_result(stmt))
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("query ERROR: %s", mysql_stmt_error(stmt));
+        mysql_free_result(metadata);
+        mysql_stmt_close(stmt);
+        return nullptr;
+    }
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s, WorldTimer::getMSTime()), sql);
+
+    uint64 rowCount = mysql_stmt_num_rows(stmt);
+    if (!rowCount)
+    {
+        mysql_free_result(metadata);
+        mysql_stmt_close(stmt);
+        return nullptr;
+    }
+
+    auto queryResult = std::make_unique<QueryResultMysqlBinary>(stmt, metadata, rowCount, mysql_num_fields(metadata));
+    if (!queryResult->NextRow())
+        return nullptr;
+
+    return queryResult;
+}
+
 QueryNamedResult* MySQLConnection::QueryNamed(const char* sql)
 {
     MYSQL_RES* result = nullptr;
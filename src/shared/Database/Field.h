@@ -34,14 +34,15 @@ class Field
             DB_TYPE_BOOL    = 0x04
         };
 
-        Field() : mValue(nullptr), mType(DB_TYPE_UNKNOWN) {}
-        Field(const char* value, enum DataTypes type) : mValue(value), mType(type) {}
+        Field() : mValue(nullptr), mType(DB_TYPE_UNKNOWN), mBinaryType(BINARY_NONE) { mBinary.i = 0; }
+        Field(const char* value, enum DataTypes type) : mValue(value), mType(type), mBinaryType(BINARY_NONE) { mBinary.i = 0; }
 
         ~Field() {}
 
         enum DataTypes GetType() const { return mType; }
         bool IsNULL() const { return mValue == nullptr; }
 
+        // string getters of numeric columns read by a binary result set return an empty string
         const char* GetString() const
         {
             return mValue ? mValue : ""; // We need this null check as we do not always null check what we get back from the database everywhere
@@ -50,15 +51,53 @@ class Field
         {
             return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
         }
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atoll(mValue)) : uint32(0); }
+        float GetFloat() const
+        {
+            if (mBinaryType != BINARY_NONE)
+                return static_cast<float>(GetBinaryDouble());
+            return mValue ? static_cast<float>(atof(mValue)) : 0.0f;
+        }
+        bool GetBool() const
+        {
+            if (mBinaryType != BINARY_NONE)
+                return GetBinaryInt() > 0;
+            return mValue ? atoi(mValue) > 0 : false;
+        }
+        int32 GetInt32() const
+        {
+            if (mBinaryType != BINARY_NONE)
+                return static_cast<int32>(GetBinaryInt());
+            return mValue ? static_cast<int32>(atol(mValue)) : int32(0);
+        }
+        uint8 GetUInt8() const
+        {
+            if (mBinaryType != BINARY_NONE)
+                return static_cast<uint8>(GetBinaryInt());
+            return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0);
+        }
+        uint16 GetUInt16() const
+        {
+            if (mBinaryType != BINARY_NONE)
+                return static_cast<uint16>(GetBinaryInt());
+            return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0);
+        }
+        int16 GetInt16() const
+        {
+            if (mBinaryType != BINARY_NONE)
+                return static_cast<int16>(GetBinaryInt());
+            return mValue ? static_cast<int16>(atol(mValue)) : int16(0);
+        }
+        uint32 GetUInt32() const
+        {
+            if (mBinaryType != BINARY_NONE)
+                return static_cast<uint32>(GetBinaryInt());
+            return mValue ? static_cast<uint32>(atoll(mValue)) : uint32(0);
+        }
         uint64 GetUInt64() const
         {
+            if (mBinaryType != BINARY_NONE)
+                return static_cast<uint64>(GetBinaryInt());
+
             uint64 value = 0;
             if (!mValue || sscanf(mValue, UI64FMTD, &value) == -1)
                 return 0;
@@ -70,13 +109,34 @@ class Field
         void SetType(enum DataTypes type) { mType = type; }
         // no need for memory allocations to store resultset field strings
         // all we need is to cache pointers returned by different DBMS APIs
-        void SetValue(const char* value) { mValue = value; }
+        void SetValue(const char* value) { mValue = value; mBinaryType = BINARY_NONE; }
+        // values decoded once by binary result sets
+        void SetValue(int64 value) { mValue = ""; mBinary.i = value; mBinaryType = BINARY_INT; }
+        void SetValue(double value) { mValue = ""; mBinary.d = value; mBinaryType = BINARY_DOUBLE; }
+        void SetNULL() { mValue = nullptr; mBinaryType = BINARY_NONE; }
 
     private:
         Field(Field const&);
         Field& operator=(Field const&);
 
+        enum BinaryTypes : uint8
+        {
+            BINARY_NONE,
+            BINARY_INT,
+            BINARY_DOUBLE
+        };
+
+        // unsigned 64 bit values are kept in the same bits, casts of getters handle both
+        int64 GetBinaryInt() const { return mBinaryType == BINARY_DOUBLE ? static_cast<int64>(mBinary.d) : mBinary.i; }
+        double GetBinaryDouble() const { return mBinaryType == BINARY_DOUBLE ? mBinary.d : static_cast<double>(mBinary.i); }
+
         const char* mValue;
         enum DataTypes mType;
+        BinaryTypes mBinaryType;
+        union
+        {
+            int64 i;
+            double d;
+        } mBinary;
 };
 #endif
@@ -67,6 +67,127 @@ void QueryResultMysql::EndQuery()
     }
 }
 
+QueryResultMysqlBinary::QueryResultMysqlBinary(MYSQL_STMT* stmt, MYSQL_RES* metadata, uint64 rowCount, uint32 fieldCount) :
+    QueryResult(rowCount, fieldCount), mStmt(stmt), mMetadata(metadata), mColumns(fieldCount), mBinds(fieldCount)
+{
+    mCurrentRow = new Field[mFieldCount];
+    MANGOS_ASSERT(mCurrentRow);
+
+    MYSQL_FIELD* fields = mysql_fetch_fields(mMetadata);
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        Column& column = mColumns[i];
+        MYSQL_BIND& bind = mBinds[i];
+        memset(&bind, 0, sizeof(MYSQL_BIND));
+
+        switch (fields[i].type)
+        {
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONGLONG:
+            case MYSQL_TYPE_YEAR:
+                column.bufferType = MYSQL_TYPE_LONGLONG;
+                bind.buffer = &column.intValue;
+                bind.is_unsigned = (fields[i].flags & UNSIGNED_FLAG) != 0;
+                mCurrentRow[i].SetType(Field::DB_TYPE_INTEGER);
+                break;
+            case MYSQL_TYPE_FLOAT:
+            case MYSQL_TYPE_DOUBLE:
+            case MYSQL_TYPE_DECIMAL:
+            case MYSQL_TYPE_NEWDECIMAL:
+                column.bufferType = MYSQL_TYPE_DOUBLE;
+                bind.buffer = &column.doubleValue;
+                mCurrentRow[i].SetType(Field::DB_TYPE_FLOAT);
+                break;
+            default:
+                // everything else as text, max_length is known after mysql_stmt_store_result
+                column.bufferType = MYSQL_TYPE_STRING;
+                // (date and time columns are converted to text by the client, their max_length is not the text size)
+                column.text.resize(std::max<unsigned long>(fields[i].max_length, 64) + 1);
+                bind.buffer = column.text.data();
+                bind.buffer_length = column.text.size();
+                mCurrentRow[i].SetType(Field::DB_TYPE_STRING);
+                break;
+        }
+
+        bind.buffer_type = column.bufferType;
+        bind.length = &column.length;
+        bind.is_null = &column.isNull;
+        bind.error = &column.truncated;
+    }
+
+    if (mysql_stmt_bind_result(mStmt, mBinds.data()))
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_bind_result() failed");
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(mStmt));
+        EndQuery();
+    }
+}
+
+QueryResultMysqlBinary::~QueryResultMysqlBinary()
+{
+    EndQuery();
+}
+
+bool QueryResultMysqlBinary::NextRow()
+{
+    if (!mStmt)
+        return false;
+
+    int status = mysql_stmt_fetch(mStmt);
+    if (status == 1 || status == MYSQL_NO_DATA)
+    {
+        EndQuery();
+        return false;
+    }
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        Column& column = mColumns[i];
+        if (column.isNull)
+        {
+            mCurrentRow[i].SetNULL();
+            continue;
+        }
+
+        switch (column.bufferType)
+        {
+            case MYSQL_TYPE_LONGLONG:
+                mCurrentRow[i].SetValue(column.intValue);
+                break;
+            case MYSQL_TYPE_DOUBLE:
+                mCurrentRow[i].SetValue(column.doubleValue);
+                break;
+            default:
+                column.text[std::min<size_t>(column.length, column.text.size() - 1)] = '\0';
+                mCurrentRow[i].SetValue(column.text.data());
+                break;
+        }
+    }
+
+    return true;
+}
+
+void QueryResultMysqlBinary::EndQuery()
+{
+    delete[] mCurrentRow;
+    mCurrentRow = nullptr;
+
+    if (mMetadata)
+    {
+        mysql_free_result(mMetadata);
+        mMetadata = nullptr;
+    }
+
+    if (mStmt)
+    {
+        mysql_stmt_close(mStmt);
+        mStmt = nullptr;
+    }
+}
+
 enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType) const
 {
     switch (mysqlType)
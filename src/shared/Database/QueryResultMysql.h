@@ -30,6 +30,8 @@
 
 #include <mysql.h>
 
+#include <vector>
+
 class QueryResultMysql : public QueryResult
 {
     public:
@@ -45,6 +47,36 @@ class QueryResultMysql : public QueryResult
 
         MYSQL_RES* mResult;
 };
+
+/// Result of a query run as prepared statement, rows come in the binary protocol and numeric columns are decoded once
+class QueryResultMysqlBinary : public QueryResult
+{
+    public:
+        QueryResultMysqlBinary(MYSQL_STMT* stmt, MYSQL_RES* metadata, uint64 rowCount, uint32 fieldCount);
+
+        ~QueryResultMysqlBinary();
+
+        bool NextRow() override;
+
+    private:
+        struct Column
+        {
+            enum_field_types bufferType;
+            int64 intValue;
+            double doubleValue;
+            std::vector<char> text;
+            unsigned long length;
+            bool isNull;
+            bool truncated;
+        };
+
+        void EndQuery();
+
+        MYSQL_STMT* mStmt;
+        MYSQL_RES* mMetadata;
+        std::vector<Column> mColumns;
+        std::vector<MYSQL_BIND> mBinds;
+};
 #endif
 #endif
 #endif
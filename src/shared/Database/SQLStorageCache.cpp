@@ -0,0 +1,288 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Database/SQLStorageCache.h"
+#include "Database/DatabaseEnv.h"
+#include "Database/DBCFileLoader.h"
+#include "Config/Config.h"
+#include "Log/Log.h"
+#include "Platform/Filesystem.h"
+#include "revision_sql.h"
+
+#include <cstdio>
+#include <thread>
+
+namespace
+{
+    uint32 const SNAPSHOT_MAGIC = 0x4353514D;               // 'MQSC'
+    uint32 const SNAPSHOT_VERSION = 1;                      // increase at any change of the file layout
+    char const* const SNAPSHOT_EXTENSION = ".sqlcache";
+
+    struct SnapshotHeader
+    {
+        uint32 magic;
+        uint32 version;
+        char revision[64];                                  // REVISION_DB_MANGOS at writing
+        uint64 contentHash;                                 // CHECKSUM TABLE at writing
+        uint64 formatHash;
+        uint64 payloadHash;
+        uint64 stringSize;
+        uint32 fieldCount;
+        uint32 rowCount;
+        uint32 maxRecordId;
+        uint32 reserved;
+    };
+
+    // FNV-1a
+    uint64 HashBytes(void const* data, size_t size, uint64 hash = 14695981039346656037ULL)
+    {
+        unsigned char const* bytes = static_cast<unsigned char const*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    uint64 HashPayload(std::vector<uint64> const& rows, std::string const& strings)
+    {
+        return HashBytes(strings.data(), strings.size(), HashBytes(rows.data(), rows.size() * sizeof(uint64)));
+    }
+
+    std::string GetSnapshotFileName(std::string const& directory, char const* tableName)
+    {
+        return directory + "/" + tableName + SNAPSHOT_EXTENSION;
+    }
+
+    class SnapshotResult : public QueryResult
+    {
+        public:
+            SnapshotResult(char const* srcFormat, uint32 fieldCount, uint32 rowCount, std::vector<uint64>&& rows, std::string&& strings) :
+                QueryResult(rowCount, fieldCount), m_srcFormat(srcFormat), m_rows(std::move(rows)), m_strings(std::move(strings)), m_nextRow(0)
+            {
+                mCurrentRow = new Field[mFieldCount];
+                for (uint32 x = 0; x < mFieldCount; ++x)
+                {
+                    switch (m_srcFormat[x])
+                    {
+                        case FT_STRING: mCurrentRow[x].SetType(Field::DB_TYPE_STRING);  break;
+                        case FT_FLOAT:  mCurrentRow[x].SetType(Field::DB_TYPE_FLOAT);   break;
+                        default:        mCurrentRow[x].SetType(Field::DB_TYPE_INTEGER); break;
+                    }
+                }
+
+                NextRow();
+            }
+
+            ~SnapshotResult() override { delete[] mCurrentRow; }
+
+            bool NextRow() override
+            {
+                if (m_nextRow >= mRowCount)
+                    return false;
+
+                uint64 const* values = &m_rows[m_nextRow * mFieldCount];
+                for (uint32 x = 0; x < mFieldCount; ++x)
+                {
+                    switch (m_srcFormat[x])
+                    {
+                        case FT_STRING:
+                            mCurrentRow[x].SetValue(m_strings.c_str() + values[x]);
+                            break;
+                        case FT_FLOAT:
+                        {
+                            double value;
+                            memcpy(&value, &values[x], sizeof(value));
+                            mCurrentRow[x].SetValue(value);
+                            break;
+                        }
+                        default:
+                            mCurrentRow[x].SetValue(int64(values[x]));
+                            break;
+                    }
+                }
+
+                ++m_nextRow;
+                return true;
+            }
+
+        private:
+            char const* m_srcFormat;
+            std::vector<uint64> m_rows;
+            std::string m_strings;
+            uint64 m_nextRow;
+    };
+}
+
+std::string SQLStorageCache::GetDirectory()
+{
+    return sConfig.GetStringDefault("WorldDatabaseCacheDir", "");
+}
+
+uint32 SQLStorageCache::Invalidate()
+{
+    std::string directory = GetDirectory();
+    if (directory.empty())
+        return 0;
+
+    boost::system::error_code error;
+    uint32 count = 0;
+    for (MaNGOS::Filesystem::directory_iterator itr(directory, error), end; !error && itr != end; itr.increment(error))
+    {
+        if (itr->path().extension() == SNAPSHOT_EXTENSION && MaNGOS::Filesystem::remove(itr->path(), error))
+            ++count;
+    }
+
+    return count;
+}
+
+bool SQLStorageCache::GetContentHash(char const* tableName, uint64& hash)
+{
+    auto queryResult = WorldDatabase.PQuery("CHECKSUM TABLE %s", tableName);
+    if (!queryResult || queryResult->GetFieldCount() < 2 || (*queryResult)[1].IsNULL())
+        return false;
+
+    hash = (*queryResult)[1].GetUInt64();
+    return true;
+}
+
+std::unique_ptr<QueryResult> SQLStorageCache::Load(char const* tableName, char const* srcFormat, uint64 contentHash, uint32& maxRecordId)
+{
+    std::string directory = GetDirectory();
+    if (directory.empty())
+        return nullptr;
+
+    FILE* file = fopen(GetSnapshotFileName(directory, tableName).c_str(), "rb");
+    if (!file)
+        return nullptr;
+
+    SnapshotHeader header;
+    bool valid = fread(&header, sizeof(header), 1, file) == 1 &&
+                 header.magic == SNAPSHOT_MAGIC && header.version == SNAPSHOT_VERSION &&
+                 strncmp(header.revision, REVISION_DB_MANGOS, sizeof(header.revision)) == 0 &&
+                 header.contentHash == contentHash && header.formatHash == HashBytes(srcFormat, strlen(srcFormat)) &&
+                 header.fieldCount == strlen(srcFormat) && header.rowCount != 0;
+
+    std::vector<uint64> rows;
+    std::string strings;
+    if (valid)
+    {
+        rows.resize(size_t(header.rowCount) * header.fieldCount);
+        strings.resize(header.stringSize);
+        valid = fread(rows.data(), sizeof(uint64), rows.size(), file) == rows.size() &&
+                fread(&strings[0], 1, strings.size(), file) == strings.size() &&
+                HashPayload(rows, strings) == header.payloadHash;
+    }
+
+    fclose(file);
+
+    if (!valid)
+    {
+        DETAIL_LOG("Snapshot of %s is stale, loading from database", tableName);
+        return nullptr;
+    }
+
+    maxRecordId = header.maxRecordId;
+    return std::unique_ptr<QueryResult>(new SnapshotResult(srcFormat, header.fieldCount, header.rowCount, std::move(rows), std::move(strings)));
+}
+
+SQLStorageCache::Writer::Writer(char const* tableName, char const* srcFormat, uint64 contentHash, uint32 maxRecordId) :
+    m_tableName(tableName), m_srcFormat(srcFormat), m_fieldCount(strlen(srcFormat)), m_contentHash(contentHash),
+    m_maxRecordId(maxRecordId), m_rowCount(0)
+{
+}
+
+void SQLStorageCache::Writer::AddRow(Field const* fields)
+{
+    // values are stored as read by the storage loader for the source format
+    for (uint32 x = 0; x < m_fieldCount; ++x)
+    {
+        uint64 value = 0;
+        switch (m_srcFormat[x])
+        {
+            case FT_STRING:
+                value = m_strings.size();
+                m_strings.append(fields[x].GetString());
+                m_strings.push_back('\0');
+                break;
+            case FT_FLOAT:
+            {
+                double floatValue = fields[x].GetFloat();
+                memcpy(&value, &floatValue, sizeof(value));
+                break;
+            }
+            case FT_BYTE:       value = fields[x].GetUInt8();  break;
+            case FT_LOGIC:
+            case FT_INT:        value = fields[x].GetUInt32(); break;
+            case FT_64BITINT:   value = fields[x].GetUInt64(); break;
+            default:
+                break;
+        }
+        m_rows.push_back(value);
+    }
+    ++m_rowCount;
+}
+
+void SQLStorageCache::Writer::SaveAsync()
+{
+    std::string directory = GetDirectory();
+    if (directory.empty() || !m_rowCount)
+        return;
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    strncpy(header.revision, REVISION_DB_MANGOS, sizeof(header.revision) - 1);
+    header.contentHash = m_contentHash;
+    header.formatHash = HashBytes(m_srcFormat, m_fieldCount);
+    header.payloadHash = HashPayload(m_rows, m_strings);
+    header.stringSize = m_strings.size();
+    header.fieldCount = m_fieldCount;
+    header.rowCount = m_rowCount;
+    header.maxRecordId = m_maxRecordId;
+
+    std::string fileName = GetSnapshotFileName(directory, m_tableName.c_str());
+    std::thread([directory, fileName, header, rows = std::move(m_rows), strings = std::move(m_strings)]()
+    {
+        boost::system::error_code error;
+        MaNGOS::Filesystem::create_directories(directory, error);
+
+        // written under a temporary name, a snapshot is never seen half written
+        std::string tempName = fileName + ".tmp";
+        FILE* file = fopen(tempName.c_str(), "wb");
+        if (!file)
+        {
+            sLog.outError("Can not write storage snapshot %s", tempName.c_str());
+            return;
+        }
+
+        bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                       fwrite(rows.data(), sizeof(uint64), rows.size(), file) == rows.size() &&
+                       fwrite(strings.data(), 1, strings.size(), file) == strings.size();
+        fclose(file);
+
+        if (written)
+            MaNGOS::Filesystem::rename(tempName, fileName, error);
+        if (!written || error)
+            MaNGOS::Filesystem::remove(tempName, error);
+    }).detach();
+
+    m_rowCount = 0;
+}
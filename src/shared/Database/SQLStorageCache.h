@@ -0,0 +1,73 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SQLSTORAGECACHE_H
+#define SQLSTORAGECACHE_H
+
+#include "Common.h"
+#include "Database/QueryResult.h"
+
+#include <memory>
+
+/**
+ * On-disk snapshot of the rows of one SQL storage table.
+ *
+ * A snapshot file starts with a header holding the world database revision, the
+ * CHECKSUM TABLE value of the table, a hash of the source format and a checksum of
+ * the payload. Rows follow as fixed size arrays of 8 byte values, then a block of
+ * zero terminated strings the string values point into.
+ *
+ * A snapshot is used only while all keys still match. Its rows are handed to the
+ * normal storage loader as a QueryResult, so custom field conversions keep working.
+ */
+class SQLStorageCache
+{
+    public:
+        // directory of the snapshot files, empty when snapshots are disabled
+        static std::string GetDirectory();
+        // removes every snapshot file, returns the number of removed files
+        static uint32 Invalidate();
+
+        // content checksum of the table, false when the database can not provide one
+        static bool GetContentHash(char const* tableName, uint64& hash);
+
+        // rows of a valid snapshot, nullptr when missing or stale
+        static std::unique_ptr<QueryResult> Load(char const* tableName, char const* srcFormat, uint64 contentHash, uint32& maxRecordId);
+
+        class Writer
+        {
+            public:
+                Writer(char const* tableName, char const* srcFormat, uint64 contentHash, uint32 maxRecordId);
+
+                void AddRow(Field const* fields);
+                // writes the snapshot from a background thread
+                void SaveAsync();
+
+            private:
+                std::string m_tableName;
+                char const* m_srcFormat;
+                uint32 m_fieldCount;
+                uint64 m_contentHash;
+                uint32 m_maxRecordId;
+                uint32 m_rowCount;
+                std::vector<uint64> m_rows;
+                std::string m_strings;
+        };
+};
+
+#endif
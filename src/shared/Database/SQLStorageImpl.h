@@ -22,6 +22,10 @@
 #include "Util/ProgressBar.h"
 #include "Log/Log.h"
 #include "DBCFileLoader.h"
+#include "Config/Config.h"
+#include "Database/SQLStorageCache.h"
+
+#include <chrono>
 
 template<class DerivedLoader, class StorageClass>
 template<class S, class D>                                  // S source-type, D destination-type
@@ -306,26 +310,49 @@ template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
     Field* fields = nullptr;
-    auto queryResult = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
-    if (!queryResult)
-    {
-        sLog.outError("Error loading %s table (not exist?)\n", store.GetTableName());
-        Log::WaitBeforeContinueIfNeed();
-        exit(1);                                            // Stop server at loading non exited table or not accessable table
-    }
-
-    uint32 maxRecordId = (*queryResult)[0].GetUInt32() + 1;
+    uint32 maxRecordId = 0;
     uint32 recordCount = 0;
     uint32 recordsize = 0;
 
-    queryResult = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName());
+    // binary results hand over numeric columns already decoded, the text protocol is kept for comparison
+    bool binaryResults = sConfig.GetBoolDefault("WorldDatabaseBinaryResults", true);
+    auto loadStart = std::chrono::steady_clock::now();
+
+    // a snapshot of unchanged table content replaces the database queries
+    uint64 contentHash = 0;
+    bool useSnapshot = !SQLStorageCache::GetDirectory().empty() && SQLStorageCache::GetContentHash(store.GetTableName(), contentHash);
+    std::unique_ptr<QueryResult> queryResult = useSnapshot ? SQLStorageCache::Load(store.GetTableName(), store.GetSrcFormat(), contentHash, maxRecordId) : nullptr;
+    std::unique_ptr<SQLStorageCache::Writer> snapshotWriter;
+    char const* loadSource = "snapshot";
+
     if (queryResult)
+        recordCount = uint32(queryResult->GetRowCount());
+    else
     {
-        fields = queryResult->Fetch();
-        recordCount = fields[0].GetUInt32();
-    }
+        queryResult = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
+        if (!queryResult)
+        {
+            sLog.outError("Error loading %s table (not exist?)\n", store.GetTableName());
+            Log::WaitBeforeContinueIfNeed();
+            exit(1);                                        // Stop server at loading non exited table or not accessable table
+        }
+
+        maxRecordId = (*queryResult)[0].GetUInt32() + 1;
+
+        queryResult = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName());
+        if (queryResult)
+        {
+            fields = queryResult->Fetch();
+            recordCount = fields[0].GetUInt32();
+        }
 
-    queryResult = WorldDatabase.PQuery("SELECT * FROM %s", store.GetTableName());
+        std::string selectAll = std::string("SELECT * FROM ") + store.GetTableName();
+        queryResult = binaryResults ? WorldDatabase.QueryBinary(selectAll.c_str()) : WorldDatabase.Query(selectAll.c_str());
+        loadSource = binaryResults ? "binary" : "text";
+
+        if (useSnapshot)
+            snapshotWriter.reset(new SQLStorageCache::Writer(store.GetTableName(), store.GetSrcFormat(), contentHash, maxRecordId));
+    }
 
     if (!queryResult)
     {
@@ -391,6 +418,9 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         fields = queryResult->Fetch();
         bar.step();
 
+        if (snapshotWriter)
+            snapshotWriter->AddRow(fields);
+
         char* record = store.createRecord(fields[0].GetUInt32());
         offset = 0;
 
@@ -440,6 +470,12 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         }
     }
     while (queryResult->NextRow());
+
+    if (snapshotWriter)
+        snapshotWriter->SaveAsync();
+
+    DETAIL_LOG("Loaded %u records from %s in %u ms (%s results)", recordCount, store.GetTableName(),
+        uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - loadStart).count()), loadSource);
 }
 
 #endif
@@ -20,7 +20,8 @@
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase) : m_dbEngine(db), m_dbConnection(conn),
+    m_pingDatabase(pingDatabase), m_running(true), m_queueSize(0), m_executed(0), m_latencySum(0), m_latencyCount(0), m_latencyMax(0)
 {
 }
 
@@ -38,23 +39,26 @@ void SqlDelayThread::run()
 #endif
 #endif
 
-    const uint32 loopSleepms = 10;
+    const std::chrono::milliseconds pingInterval(std::max(m_dbEngine->GetPingIntervall(), uint32(IN_MILLISECONDS)));
+    auto nextPing = std::chrono::steady_clock::now() + pingInterval;
 
-    const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
-
-    uint32 loopCounter = 0;
     while (m_running)
     {
+        {
+            // sleep until there is work, a stop request or the next ping is due
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCondition.wait_until(lock, nextPing, [this]() { return !m_sqlQueue.empty() || !m_running; });
+        }
+
         // if the running state gets turned off while sleeping
         // empty the queue before exiting
-        MaNGOS::Thread::Sleep(loopSleepms);
-
         ProcessRequests();
 
-        if ((loopCounter++) >= pingEveryLoop)
+        if (std::chrono::steady_clock::now() >= nextPing)
         {
-            loopCounter = 0;
-            m_dbEngine->Ping();
+            nextPing = std::chrono::steady_clock::now() + pingInterval;
+            if (m_pingDatabase)
+                m_dbEngine->Ping();
         }
     }
 
@@ -67,12 +71,16 @@ void SqlDelayThread::run()
 
 void SqlDelayThread::Stop()
 {
-    m_running = false;
+    {
+        std::lock_guard<std::mutex> guard(m_queueMutex);
+        m_running = false;
+    }
+    m_queueCondition.notify_all();
 }
 
 void SqlDelayThread::ProcessRequests()
 {
-    std::queue<std::unique_ptr<SqlOperation>> sqlQueue;
+    std::queue<DelayedOperation> sqlQueue;
 
     // we need to move the contents of the queue to a local copy because executing these statements with the
     // lock in place can result in a deadlock with the world thread which calls Database::ProcessResultQueue()
@@ -83,8 +91,30 @@ void SqlDelayThread::ProcessRequests()
 
     while (!sqlQueue.empty())
     {
-        auto const s = std::move(sqlQueue.front());
+        DelayedOperation const s = std::move(sqlQueue.front());
         sqlQueue.pop();
-        s->Execute(m_dbConnection);
+        s.operation->Execute(m_dbConnection);
+
+        uint32 latency = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s.queued).count());
+        m_latencySum += latency;
+        ++m_latencyCount;
+        uint32 latencyMax = m_latencyMax;
+        while (latency > latencyMax && !m_latencyMax.compare_exchange_weak(latencyMax, latency)) {}
+
+        --m_queueSize;
+        ++m_executed;
     }
 }
+
+SqlDelayThreadStats SqlDelayThread::CollectStats()
+{
+    SqlDelayThreadStats stats;
+    stats.queued = m_queueSize;
+    stats.executed = m_executed;
+
+    uint64 latencySum = m_latencySum.exchange(0);
+    uint32 latencyCount = m_latencyCount.exchange(0);
+    stats.averageLatency = latencyCount ? uint32(latencySum / latencyCount) : 0;
+    stats.maxLatency = m_latencyMax.exchange(0);
+    return stats;
+}
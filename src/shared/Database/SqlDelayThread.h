@@ -23,6 +23,8 @@
 #include "SqlOperations.h"
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -31,30 +33,60 @@ class Database;
 class SqlOperation;
 class SqlConnection;
 
+/// Queue state of one async connection, latencies are in microseconds from Delay() to finished execution
+struct SqlDelayThreadStats
+{
+    uint32 queued;                                          ///< operations waiting right now
+    uint64 executed;                                        ///< operations executed since start
+    uint32 averageLatency;                                  ///< since the previous CollectStats() call
+    uint32 maxLatency;                                      ///< since the previous CollectStats() call
+};
+
 class SqlDelayThread : public MaNGOS::Runnable
 {
     private:
+        struct DelayedOperation
+        {
+            std::unique_ptr<SqlOperation> operation;
+            std::chrono::steady_clock::time_point queued;
+        };
+
         std::mutex m_queueMutex;
-        std::queue<std::unique_ptr<SqlOperation>> m_sqlQueue;   ///< Queue of SQL statements
-        Database* m_dbEngine;                                   ///< Pointer to used Database engine
-        SqlConnection* m_dbConnection;                          ///< Pointer to DB connection
+        std::condition_variable m_queueCondition;           ///< Wakes the thread on new statements and on stop
+        std::queue<DelayedOperation> m_sqlQueue;            ///< Queue of SQL statements
+        Database* m_dbEngine;                               ///< Pointer to used Database engine
+        SqlConnection* m_dbConnection;                      ///< Pointer to DB connection
+        bool m_pingDatabase;                                ///< Only one thread of a database keeps all its connections alive
         std::atomic<bool> m_running;
 
+        std::atomic<uint32> m_queueSize;
+        std::atomic<uint64> m_executed;
+        std::atomic<uint64> m_latencySum;
+        std::atomic<uint32> m_latencyCount;
+        std::atomic<uint32> m_latencyMax;
+
         // process all enqueued requests
         void ProcessRequests();
 
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase = true);
         ~SqlDelayThread();
 
         ///< Put sql statement to delay queue
         bool Delay(SqlOperation* sql)
         {
-            std::lock_guard<std::mutex> guard(m_queueMutex);
-            m_sqlQueue.push(std::unique_ptr<SqlOperation>(sql));
+            {
+                std::lock_guard<std::mutex> guard(m_queueMutex);
+                m_sqlQueue.push({ std::unique_ptr<SqlOperation>(sql), std::chrono::steady_clock::now() });
+            }
+            ++m_queueSize;
+            m_queueCondition.notify_one();
             return true;
         }
 
+        // latency counters restart with every call
+        SqlDelayThreadStats CollectStats();
+
         virtual void Stop();                                ///< Stop event
         virtual void run();                                 ///< Main Thread loop
 };
@@ -24,6 +24,8 @@
 #include <cstdarg>
 
 #define LOCK_DB_CONN(conn) SqlConnection::Lock guard(conn)
+// rows per multi row request, keeps them well below max_allowed_packet
+#define MAX_BATCH_ROWS 256
 
 /// ---- ASYNC STATEMENTS / TRANSACTIONS ----
 
@@ -53,20 +55,78 @@ bool SqlTransaction::Execute(SqlConnection* conn)
     conn->BeginTransaction();
 
     const int nItems = m_queue.size();
-    for (int i = 0; i < nItems; ++i)
+    for (int i = 0; i < nItems;)
     {
         SqlOperation* pStmt = m_queue[i];
 
+        // consecutive executions of the same prepared statement go as one batch, see SqlConnection::ExecuteStmtBatch
+        if (SqlPreparedRequest* pRequest = dynamic_cast<SqlPreparedRequest*>(pStmt))
+        {
+            std::vector<const SqlStmtParameters*> rows(1, pRequest->GetParams());
+            while (i + int(rows.size()) < nItems && rows.size() < MAX_BATCH_ROWS)
+            {
+                SqlPreparedRequest* pNext = dynamic_cast<SqlPreparedRequest*>(m_queue[i + rows.size()]);
+                if (!pNext || pNext->GetIndex() != pRequest->GetIndex())
+                    break;
+
+                rows.push_back(pNext->GetParams());
+            }
+
+            if (rows.size() > 1)
+            {
+                if (!conn->ExecuteStmtBatch(pRequest->GetIndex(), rows))
+                {
+                    conn->RollbackTransaction();
+                    return false;
+                }
+
+                i += rows.size();
+                continue;
+            }
+        }
+
         if (!pStmt->Execute(conn))
         {
             conn->RollbackTransaction();
             return false;
         }
+        ++i;
     }
 
     return conn->CommitTransaction();
 }
 
+void SqlFence::Arrive()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    --m_waiting;
+    m_condition.notify_all();
+    m_condition.wait(lock, [this]() { return m_done; });
+}
+
+void SqlFence::WaitArrivals()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this]() { return m_waiting == 0; });
+}
+
+void SqlFence::Release()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_done = true;
+    }
+    m_condition.notify_all();
+}
+
+bool SqlFencedOperation::Execute(SqlConnection* conn)
+{
+    m_fence->WaitArrivals();
+    bool result = m_operation->Execute(conn);
+    m_fence->Release();
+    return result;
+}
+
 SqlPreparedRequest::SqlPreparedRequest(int nIndex, SqlStmtParameters* arg) : m_nIndex(nIndex), m_param(arg)
 {
 }
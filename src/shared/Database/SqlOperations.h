@@ -24,6 +24,7 @@
 
 #include <queue>
 #include <vector>
+#include <condition_variable>
 #include <mutex>
 #include <memory>
 
@@ -58,16 +59,57 @@ class SqlTransaction : public SqlOperation
 {
     private:
         std::vector<SqlOperation* > m_queue;
+        std::vector<uint32> m_serialKeys;
 
     public:
-        SqlTransaction() {}
+        SqlTransaction(std::vector<uint32> serialKeys) : m_serialKeys(std::move(serialKeys)) {}
         ~SqlTransaction();
 
         void DelayExecute(SqlOperation* sql) { m_queue.push_back(sql); }
+        std::vector<uint32> const& GetSerialKeys() const { return m_serialKeys; }
 
         bool Execute(SqlConnection* conn) override;
 };
 
+/// Orders one operation with the requests of several async connections: the connection executing it
+/// waits until all others reached the fence, and those wait until the operation is done
+class SqlFence
+{
+    public:
+        explicit SqlFence(uint32 waiting) : m_waiting(waiting), m_done(false) {}
+
+        // called by a waiting connection, returns once the fenced operation is done
+        void Arrive();
+        // called by the executing connection around the fenced operation
+        void WaitArrivals();
+        void Release();
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        uint32 m_waiting;
+        bool m_done;
+};
+
+class SqlFenceWait : public SqlOperation
+{
+    private:
+        std::shared_ptr<SqlFence> m_fence;
+    public:
+        explicit SqlFenceWait(std::shared_ptr<SqlFence> fence) : m_fence(std::move(fence)) {}
+        bool Execute(SqlConnection* /*conn*/) override { m_fence->Arrive(); return true; }
+};
+
+class SqlFencedOperation : public SqlOperation
+{
+    private:
+        std::shared_ptr<SqlFence> m_fence;
+        std::unique_ptr<SqlOperation> m_operation;
+    public:
+        SqlFencedOperation(std::shared_ptr<SqlFence> fence, SqlOperation* operation) : m_fence(std::move(fence)), m_operation(operation) {}
+        bool Execute(SqlConnection* conn) override;
+};
+
 class SqlPreparedRequest : public SqlOperation
 {
     public:
@@ -76,6 +118,9 @@ class SqlPreparedRequest : public SqlOperation
 
         bool Execute(SqlConnection* conn) override;
 
+        int GetIndex() const { return m_nIndex; }
+        const SqlStmtParameters* GetParams() const { return m_param; }
+
     private:
         const int m_nIndex;
         SqlStmtParameters* m_param;
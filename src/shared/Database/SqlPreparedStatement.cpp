@@ -18,6 +18,8 @@
 
 #include "DatabaseEnv.h"
 
+#include <limits>
+
 SqlStmtParameters::SqlStmtParameters(uint32 nParams)
 {
     // reserve memory if needed
@@ -83,6 +85,67 @@ bool SqlStatement::DirectExecute()
     return m_pDB->DirectExecuteStmt(m_index, args);
 }
 
+//////////////////////////////////////////////////////////////////////////
+// position of the "(?, ...)" row of "INSERT ... VALUES (?, ...)" if it holds all placeholders and ends the statement
+static size_t FindBatchRow(const std::string& fmt)
+{
+    if (strnicmp(fmt.c_str(), "insert", 6) != 0 && strnicmp(fmt.c_str(), "replace", 7) != 0)
+        return std::string::npos;
+
+    size_t rowPos = fmt.rfind('(');
+    if (rowPos == std::string::npos)
+        return std::string::npos;
+
+    size_t rowEnd = fmt.find(')', rowPos);
+    if (rowEnd == std::string::npos || fmt.find_first_not_of(" ;", rowEnd + 1) != std::string::npos)
+        return std::string::npos;
+
+    if (fmt.find_first_not_of("?, ", rowPos + 1) != rowEnd || fmt.find('?') < rowPos)
+        return std::string::npos;
+
+    size_t keywordEnd = fmt.find_last_not_of(' ', rowPos - 1);
+    if (keywordEnd == std::string::npos || keywordEnd < 5 || strnicmp(fmt.c_str() + keywordEnd - 5, "values", 6) != 0)
+        return std::string::npos;
+
+    return rowPos;
+}
+
+SqlPreparedStatement::SqlPreparedStatement(const std::string& fmt, SqlConnection& conn) :
+    m_nParams(0), m_nColumns(0), m_bIsQuery(false),
+    m_bPrepared(false), m_szFmt(fmt), m_nBatchRowPos(FindBatchRow(fmt)), m_pConn(conn)
+{
+}
+
+std::string SqlPreparedStatement::batchRequest(const std::vector<const SqlStmtParameters*>& rows) const
+{
+    MANGOS_ASSERT(isBatchable());
+
+    size_t rowEnd = m_szFmt.find(')', m_nBatchRowPos);
+
+    std::ostringstream request;
+    // keep floats exact, the binary prepared statements would not round them either
+    request.precision(std::numeric_limits<double>::max_digits10);
+    request.write(m_szFmt.c_str(), m_nBatchRowPos);
+
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        if (i > 0)
+            request << ',';
+
+        SqlStmtParameters::ParameterContainer const& args = rows[i]->params();
+        size_t nArg = 0;
+        for (size_t pos = m_nBatchRowPos; pos <= rowEnd; ++pos)
+        {
+            if (m_szFmt[pos] == '?' && nArg < args.size())
+                SqlPlainPreparedStatement::DataToString(args[nArg++], request, m_pConn.DB());
+            else
+                request << m_szFmt[pos];
+        }
+    }
+
+    return request.str();
+}
+
 //////////////////////////////////////////////////////////////////////////
 SqlPlainPreparedStatement::SqlPlainPreparedStatement(const std::string& fmt, SqlConnection& conn) : SqlPreparedStatement(fmt, conn)
 {
@@ -113,7 +176,7 @@ void SqlPlainPreparedStatement::bind(const SqlStmtParameters& holder)
         const SqlStmtFieldData& data = (*iter);
 
         std::ostringstream fmt;
-        DataToString(data, fmt);
+        DataToString(data, fmt, m_pConn.DB());
 
         nLastPos = m_szPlainRequest.find('?', nLastPos);
         if (nLastPos != std::string::npos)
@@ -133,7 +196,7 @@ bool SqlPlainPreparedStatement::execute()
     return m_pConn.Execute(m_szPlainRequest.c_str());
 }
 
-void SqlPlainPreparedStatement::DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt) const
+void SqlPlainPreparedStatement::DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt, Database& db)
 {
     switch (data.type())
     {
@@ -151,7 +214,7 @@ void SqlPlainPreparedStatement::DataToString(const SqlStmtFieldData& data, std::
         case FIELD_STRING:
         {
             std::string tmp = data.toStr();
-            m_pConn.DB().escape_string(tmp);
+            db.escape_string(tmp);
             fmt << "'" << tmp << "'";
             break;
         }
@@ -310,17 +310,20 @@ class SqlPreparedStatement
         // execute statement w/o result set
         virtual bool execute() = 0;
 
+        // INSERT/REPLACE ending with a single "VALUES (?, ...)" row, several executions can be sent as one multi row request
+        bool isBatchable() const { return m_nBatchRowPos != std::string::npos; }
+        // plain SQL request inserting all rows at once, only for batchable statements
+        std::string batchRequest(const std::vector<const SqlStmtParameters*>& rows) const;
+
     protected:
-        SqlPreparedStatement(const std::string& fmt, SqlConnection& conn) :
-            m_nParams(0), m_nColumns(0), m_bIsQuery(false),
-            m_bPrepared(false), m_szFmt(fmt), m_pConn(conn)
-        {}
+        SqlPreparedStatement(const std::string& fmt, SqlConnection& conn);
 
         uint32 m_nParams;
         uint32 m_nColumns;
         bool m_bIsQuery;
         bool m_bPrepared;
         std::string m_szFmt;
+        size_t m_nBatchRowPos;
         SqlConnection& m_pConn;
 };
 
@@ -339,8 +342,8 @@ class SqlPlainPreparedStatement : public SqlPreparedStatement
 
         virtual bool execute() override;
 
+        static void DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt, Database& db);
     protected:
-        void DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt) const;
 
         std::string m_szPlainRequest;
 };
@@ -23,6 +23,7 @@
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
 #include "AsyncSocket.hpp"
+#include "NetworkThreadPool.hpp"
 
 namespace MaNGOS
 {
@@ -31,24 +32,39 @@ namespace MaNGOS
     {
         public:
             // constructor for accepting connection from client
-            AsyncListener(boost::asio::io_context& io_context, std::string const& bindIp, unsigned short port) : m_context(io_context), m_acceptor(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(bindIp), port))
+            AsyncListener(boost::asio::io_context& io_context, std::string const& bindIp, unsigned short port) : m_context(io_context), m_threadPool(nullptr), m_acceptor(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(bindIp), port))
+            {
+                startAccept();
+            }
+            // constructor for accepting on io_context and handing every connection to a thread of the pool
+            AsyncListener(boost::asio::io_context& io_context, NetworkThreadPool& threadPool, std::string const& bindIp, unsigned short port) : m_context(io_context), m_threadPool(&threadPool), m_acceptor(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address(bindIp), port))
             {
                 startAccept();
             }
             void HandleAccept(std::shared_ptr<SocketType> connection, const boost::system::error_code& err)
             {
+                // start on the owning thread so no handler of the connection ever runs elsewhere
                 if (!err)
-                    connection->Start();
+                    boost::asio::post(connection->GetAsioSocket().get_executor(), [connection]() { connection->Start(); });
 
                 startAccept();
             }
         private:
             boost::asio::io_context& m_context;
+            NetworkThreadPool* m_threadPool;
             boost::asio::ip::tcp::acceptor m_acceptor;
             void startAccept()
             {
                 // socket
-                std::shared_ptr<SocketType> connection = std::make_shared<SocketType>(m_context);
+                std::shared_ptr<SocketType> connection;
+                if (m_threadPool)
+                {
+                    NetworkThread& thread = m_threadPool->SelectThread();
+                    connection = std::make_shared<SocketType>(thread.GetContext());
+                    connection->SetSocketCounter(thread.GetSocketCounter());
+                }
+                else
+                    connection = std::make_shared<SocketType>(m_context);
 
                 // asynchronous accept operation and wait for a new connection.
                 m_acceptor.async_accept(connection->GetAsioSocket(), boost::bind(&AsyncListener::HandleAccept, this, connection, boost::asio::placeholders::error));
@@ -25,6 +25,9 @@
 #include "boost/lexical_cast.hpp"
 #include "Log/Log.h"
 
+#include <atomic>
+#include <memory>
+
 namespace MaNGOS
 {
     // this socket is different in that it does not block on reads
@@ -36,6 +39,7 @@ namespace MaNGOS
             virtual ~AsyncSocket();
 
             void Read(char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
+            void ReadSome(char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
             void ReadUntil(std::string& buffer, char delimiter, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
             void ReadSkip(size_t skipSize, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
             void Write(const char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback);
@@ -60,6 +64,13 @@ namespace MaNGOS
 
             std::string const& GetRemoteEndpoint() const { return m_remoteEndpoint; }
             std::string const& GetRemoteAddress() const { return m_address; }
+
+            // counter of the network thread owning this socket, decremented when the socket is destroyed
+            void SetSocketCounter(std::shared_ptr<std::atomic<uint32>> const& counter)
+            {
+                m_socketCounter = counter;
+                ++*m_socketCounter;
+            }
         private:
             virtual bool ProcessIncomingData() = 0;
             virtual bool OnOpen() = 0;
@@ -71,6 +82,7 @@ namespace MaNGOS
             std::string m_remoteEndpoint;
             boost::asio::ip::address m_remoteAddress;
             uint16 m_remotePort;
+            std::shared_ptr<std::atomic<uint32>> m_socketCounter;
     };
 
     template <typename SocketType>
@@ -84,6 +96,8 @@ namespace MaNGOS
     MaNGOS::AsyncSocket<SocketType>::~AsyncSocket()
     {
         m_socket.close();
+        if (m_socketCounter)
+            --*m_socketCounter;
     }
 
     template <typename SocketType>
@@ -92,6 +106,12 @@ namespace MaNGOS
         boost::asio::async_read(m_socket, boost::asio::buffer(buffer, length), callback);
     }
 
+    template <typename SocketType>
+    void MaNGOS::AsyncSocket<SocketType>::ReadSome(char* buffer, size_t length, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
+    {
+        m_socket.async_read_some(boost::asio::buffer(buffer, length), callback);
+    }
+
     template <typename SocketType>
     void MaNGOS::AsyncSocket<SocketType>::ReadUntil(std::string& buffer, char delimiter, std::function<void(const boost::system::error_code&, std::size_t)>&& callback)
     {
@@ -0,0 +1,113 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOSSERVER_NETWORK_THREAD_POOL
+#define MANGOSSERVER_NETWORK_THREAD_POOL
+
+#include "Platform/Define.h"
+#include <boost/asio.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace MaNGOS
+{
+    enum class NetworkThreadAssignment
+    {
+        ROUND_ROBIN     = 0,
+        LEAST_LOADED    = 1,
+    };
+
+    // one io_context with the single thread running it, every socket created on it keeps all its handlers there
+    class NetworkThread
+    {
+        public:
+            NetworkThread() : m_work(boost::asio::make_work_guard(m_context)), m_socketCount(std::make_shared<std::atomic<uint32>>(0)) {}
+            NetworkThread(const NetworkThread&) = delete;
+
+            void Start() { m_thread = std::thread([this]() { m_context.run(); }); }
+            void Stop()
+            {
+                m_work.reset();
+                m_context.stop();
+                if (m_thread.joinable())
+                    m_thread.join();
+            }
+
+            boost::asio::io_context& GetContext() { return m_context; }
+
+            // shared with the sockets, which may outlive the thread during shutdown
+            std::shared_ptr<std::atomic<uint32>> const& GetSocketCounter() const { return m_socketCount; }
+            uint32 GetSocketCount() const { return *m_socketCount; }
+
+        private:
+            boost::asio::io_context m_context;
+            boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_work;
+            std::shared_ptr<std::atomic<uint32>> m_socketCount;
+            std::thread m_thread;
+    };
+
+    class NetworkThreadPool
+    {
+        public:
+            NetworkThreadPool(size_t threadCount, NetworkThreadAssignment assignment) : m_assignment(assignment), m_nextThread(0)
+            {
+                for (size_t i = 0; i < threadCount; ++i)
+                    m_threads.emplace_back(std::make_unique<NetworkThread>());
+
+                for (auto& thread : m_threads)
+                    thread->Start();
+            }
+            NetworkThreadPool(const NetworkThreadPool&) = delete;
+            ~NetworkThreadPool() { Stop(); }
+
+            void Stop()
+            {
+                for (auto& thread : m_threads)
+                    thread->Stop();
+            }
+
+            // only called from the accepting thread
+            NetworkThread& SelectThread()
+            {
+                if (m_assignment == NetworkThreadAssignment::LEAST_LOADED)
+                {
+                    NetworkThread* selected = m_threads.front().get();
+                    for (auto& thread : m_threads)
+                        if (thread->GetSocketCount() < selected->GetSocketCount())
+                            selected = thread.get();
+                    return *selected;
+                }
+
+                NetworkThread& selected = *m_threads[m_nextThread];
+                m_nextThread = (m_nextThread + 1) % m_threads.size();
+                return selected;
+            }
+
+            size_t GetThreadCount() const { return m_threads.size(); }
+
+        private:
+            std::vector<std::unique_ptr<NetworkThread>> m_threads;
+            NetworkThreadAssignment m_assignment;
+            size_t m_nextThread;
+    };
+}
+
+#endif
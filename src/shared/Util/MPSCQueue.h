@@ -0,0 +1,115 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _MPSCQ_H
+#define _MPSCQ_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/**
+ * Bounded lock-free queue for many producers and one consumer.
+ *
+ * Every slot carries a sequence number telling whether it is free for the producer
+ * of that position or filled for the consumer, so neither side ever blocks.
+ * The consumer side is not synchronized, it may move between threads only if
+ * those threads are otherwise ordered (e.g. world update and map update phases).
+ */
+template <typename T>
+class MPSCQueue
+{
+    public:
+        // capacity is rounded up to a power of two
+        explicit MPSCQueue(size_t capacity) : m_enqueuePos(0), m_dequeuePos(0)
+        {
+            size_t size = 2;
+            while (size < capacity)
+                size <<= 1;
+
+            m_mask = size - 1;
+            m_cells = std::make_unique<Cell[]>(size);
+            for (size_t i = 0; i < size; ++i)
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        MPSCQueue(const MPSCQueue<T>&) = delete;
+
+        // false when the queue is full, value is left untouched then
+        bool Enqueue(T&& value)
+        {
+            Cell* cell;
+            size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+            while (true)
+            {
+                cell = &m_cells[pos & m_mask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos);
+                if (diff == 0)
+                {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false;
+                else
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+
+            cell->data = std::move(value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // consumer only
+        bool Dequeue(T& value)
+        {
+            Cell& cell = m_cells[m_dequeuePos & m_mask];
+            if (cell.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+                return false;
+
+            value = std::move(cell.data);
+            cell.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+            ++m_dequeuePos;
+            return true;
+        }
+
+        // consumer only
+        bool Empty() const { return m_cells[m_dequeuePos & m_mask].sequence.load(std::memory_order_acquire) != m_dequeuePos + 1; }
+
+        size_t Capacity() const { return m_mask + 1; }
+
+        // values enqueued (or being enqueued) since creation, any thread
+        size_t EnqueuedCount() const { return m_enqueuePos.load(std::memory_order_acquire); }
+        // consumer only, values dequeued since creation
+        size_t DequeuedCount() const { return m_dequeuePos; }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        std::unique_ptr<Cell[]> m_cells;
+        size_t m_mask;
+
+        alignas(64) std::atomic<size_t> m_enqueuePos;
+        alignas(64) size_t m_dequeuePos;
+};
+
+#endif
@@ -3,5 +3,5 @@
  #define REVISION_DB_REALMD "required_s2474_01_realmd_joindate_datetime"
  #define REVISION_DB_LOGS "required_s2433_01_logs_anticheat"
  #define REVISION_DB_CHARACTERS "required_s2473_01_characters_item_instance_text_id_fix"
- #define REVISION_DB_MANGOS "required_s2485_01_mangos_closing_text"
+ #define REVISION_DB_MANGOS "required_s2487_01_mangos_reload_storage_cache"
 #endif // __REVISION_SQL_H__